@@ -0,0 +1,356 @@
+/**
+ * Benchmarks of the hot paths of cdf on synthetic datasets.
+ *
+ * Build and run from the repository root:
+ * ```
+ * g++ -std=c++17 -O2 -pthread bench/benchmark.cpp -o benchmark
+ * ./benchmark                       # table on stdout
+ * ./benchmark --json > results.jsonl  # one JSON object per benchmark, for tracking across releases
+ * ```
+ *
+ * Options:
+ *   --json            Prints one JSON object per line instead of a table
+ *   --filter <text>   Only runs the benchmarks whose "dataset/name" contains the text
+ *   --scale <x>       Multiplies the number of rows of every dataset (default is 1)
+ *   --threads <n>     Number of threads used by parallel operations (default is every core)
+ *   --min-time <s>    Minimum measured time per benchmark in seconds (default is 0.2)
+ *   --tmp <dir>       Directory receiving the generated CSV files (default is /tmp)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "generators.hpp"
+
+namespace {
+
+struct Options {
+    bool json = false;
+    std::string filter;
+    double scale = 1;
+    size_t threads = 0;
+    double minTime = 0.2;
+    std::string tmpDir = "/tmp";
+};
+
+struct Result {
+    std::string dataset;
+    std::string name;
+    size_t rows;
+    size_t bytes;
+    size_t iterations;
+    double seconds; /**< Median time of one iteration */
+};
+
+/**
+ * @brief Keeps the compiler from optimizing away a result
+ */
+template <typename T>
+void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Stream buffer counting the bytes written to it, used to measure printing without a terminal
+ */
+class CountingBuffer : public std::streambuf {
+   public:
+    size_t count = 0;
+
+   protected:
+    int overflow(int c) override {
+        count++;
+        return c;
+    }
+    std::streamsize xsputn(const char*, std::streamsize n) override {
+        count += n;
+        return n;
+    }
+};
+
+class Runner {
+    Options options;
+
+    void report(const Result& result) {
+        double rowsPerSecond = result.rows / result.seconds;
+        double bytesPerSecond = result.bytes / result.seconds;
+        if (options.json) {
+            std::printf(
+                "{\"dataset\":\"%s\",\"benchmark\":\"%s\",\"rows\":%zu,\"bytes\":%zu,\"iterations\":%zu,"
+                "\"threads\":%zu,\"seconds\":%.9g,\"rows_per_second\":%.6g,\"bytes_per_second\":%.6g}\n",
+                result.dataset.c_str(), result.name.c_str(), result.rows, result.bytes, result.iterations,
+                cdf::get_num_threads(), result.seconds, rowsPerSecond, bytesPerSecond);
+        } else {
+            std::printf("%-8s %-20s %10zu %8zu %12.3f %14.3e %12.1f\n", result.dataset.c_str(), result.name.c_str(),
+                        result.rows, result.iterations, result.seconds * 1e3, rowsPerSecond, bytesPerSecond / 1e6);
+        }
+        std::fflush(stdout);
+    }
+
+   public:
+    explicit Runner(const Options& options) : options(options) {
+        if (!options.json) {
+            std::printf("%-8s %-20s %10s %8s %12s %14s %12s\n", "dataset", "benchmark", "rows", "iters", "median ms",
+                        "rows/s", "MB/s");
+        }
+    }
+
+    bool selected(const std::string& dataset, const std::string& name) const {
+        return (dataset + "/" + name).find(options.filter) != std::string::npos;
+    }
+
+    /**
+     * @brief Times a benchmark: one warm-up run, then at least 5 runs and minTime seconds, reports the median run.
+     *
+     * @param rows Rows processed by one run
+     * @param bytes Bytes processed by one run
+     */
+    void run(const std::string& dataset, const std::string& name, size_t rows, size_t bytes,
+             const std::function<void()>& body) {
+        if (!selected(dataset, name)) {
+            return;
+        }
+        using Clock = std::chrono::steady_clock;
+        body();
+
+        std::vector<double> times;
+        double total = 0;
+        while (times.size() < 5 || total < options.minTime) {
+            auto start = Clock::now();
+            body();
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            times.push_back(elapsed);
+            total += elapsed;
+        }
+        std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+        Result result{dataset, name, rows, bytes, times.size(), times[times.size() / 2]};
+        report(result);
+    }
+};
+
+/**
+ * @brief Tells whether two frames hold the same values in the given columns
+ */
+bool sameValues(cdf::DataFrame& a, cdf::DataFrame& b, const std::vector<std::string>& columns) {
+    if (a.shape().first != b.shape().first) {
+        return false;
+    }
+    for (auto& name : columns) {
+        cdf::core::Series left = a[name], right = b[name];
+        for (size_t i = 0; i < left.size(); i++) {
+            if (!(left[i] == right[i])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Runs the micro benchmarks of every operation on one dataset, and the read-filter-aggregate pipeline
+ */
+void benchDataset(Runner& runner, const cdf::bench::DatasetSpec& spec, const Options& options) {
+    std::string csvPath = options.tmpDir + "/cdf_bench_" + spec.name + ".csv";
+    size_t csvBytes = cdf::bench::writeCsv(spec, csvPath);
+    cdf::DataFrame df = cdf::bench::generate(spec);
+
+    size_t rows = spec.rows;
+    size_t frameBytes = 0;
+    for (auto& name : cdf::bench::columnNames(spec)) {
+        frameBytes += cdf::bench::payloadBytes(df[name]);
+    }
+
+    // Numeric column for the comparisons and reductions, string column for the string paths
+    std::string numeric = spec.doubleColumns ? "d0" : "i0";
+    std::string text = "s0";
+    int threshold = spec.cardinality / 2;
+    size_t numericBytes = cdf::bench::payloadBytes(df[numeric]);
+    size_t intBytes = cdf::bench::payloadBytes(df["i0"]);
+    size_t textBytes = spec.stringColumns ? cdf::bench::payloadBytes(df[text]) : 0;
+
+    runner.run(spec.name, "read_csv", rows, csvBytes, [&] { keep(cdf::io::read_csv(csvPath)); });
+
+    std::vector<int> everyOther;
+    for (size_t i = 0; i < rows; i += 2) {
+        everyOther.push_back(i);
+    }
+    runner.run(spec.name, "filter_indices", everyOther.size(), frameBytes / 2,
+               [&] { keep(df.filter(everyOther)); });
+    runner.run(spec.name, "filter_expression", rows, frameBytes,
+               [&] { keep(df[cdf::col("i0") < threshold]); });
+    runner.run(spec.name, "filter_mask", rows, frameBytes, [&] { keep(df[df["i0"] < threshold]); });
+
+    std::vector<std::string> names = cdf::bench::columnNames(spec);
+    std::vector<std::string> projected = {"i0"};
+    if (numeric != "i0") {
+        projected.push_back(numeric);
+    }
+    if (spec.stringColumns) {
+        projected.push_back(text);
+    }
+    runner.run(spec.name, "projection", rows, frameBytes * projected.size() / names.size(),
+               [&] { keep(df[projected]); });
+    runner.run(spec.name, "iloc", rows / 2, frameBytes / 2, [&] { keep(df.iloc(rows / 4, rows / 4 + rows / 2 - 1)); });
+
+    // Micro-batches appended one by one, as chunks
+    std::vector<cdf::DataFrame> batches;
+    for (size_t begin = 0; begin < rows; begin += 1000) {
+        batches.push_back(df.iloc(begin, std::min<size_t>(rows, begin + 1000) - 1));
+    }
+    runner.run(spec.name, "append", rows, frameBytes, [&] {
+        cdf::DataFrame live;
+        for (auto& batch : batches) {
+            live.append(batch);
+        }
+        keep(live);
+    });
+
+    // Refresh of a reader over a LiveFrame: one row published, then the filter of filter_expression on a snapshot
+    cdf::LiveFrame appended;
+    for (auto& batch : batches) {
+        appended.append(batch);
+    }
+    cdf::DataFrame oneRow = df.iloc(0, 0);
+    runner.run(spec.name, "snapshot_query", rows, frameBytes, [&] {
+        appended.append(oneRow);
+        cdf::DataFrame snapshot = appended.snapshot();
+        keep(snapshot[cdf::col("i0") < threshold]);
+    });
+
+    runner.run(spec.name, "compare_int", rows, intBytes, [&] { keep(df["i0"] > threshold); });
+    if (spec.stringColumns) {
+        std::string probe;
+        for (auto& value : df[text]) {
+            if (std::holds_alternative<std::string>(value)) {
+                probe = std::get<std::string>(value);
+                break;
+            }
+        }
+        runner.run(spec.name, "compare_string", rows, textBytes, [&] { keep(df[text] == probe); });
+        runner.run(spec.name, "mode_string", rows, textBytes, [&] { keep(df[text].mode()); });
+    }
+
+    std::vector<int> wanted;
+    for (int k = 0; k < 16; k++) {
+        wanted.push_back(k * 7 % spec.cardinality);
+    }
+    runner.run(spec.name, "isin", rows, intBytes, [&] { keep(df["i0"].isin(wanted)); });
+
+    runner.run(spec.name, "sum", rows, numericBytes, [&] { keep(df[numeric].sum()); });
+    runner.run(spec.name, "mean", rows, numericBytes, [&] { keep(df[numeric].mean()); });
+    runner.run(spec.name, "median", rows, numericBytes, [&] { keep(df[numeric].median()); });
+    runner.run(spec.name, "mode", rows, numericBytes, [&] { keep(df[numeric].mode<double>()); });
+    runner.run(spec.name, "rolling_mean", rows, numericBytes, [&] { keep(df[numeric].rolling(300).mean()); });
+    runner.run(spec.name, "rolling_max", rows, numericBytes, [&] { keep(df[numeric].rolling(300).max()); });
+    runner.run(spec.name, "cumsum", rows, numericBytes, [&] { keep(df[numeric].cumsum()); });
+
+    // Printing goes to a counting buffer, bytes/s is the rate of formatted output
+    int printed = std::min<size_t>(rows, 1000);
+    CountingBuffer sink;
+    std::streambuf* console = std::cout.rdbuf(&sink);
+    df.head(printed);
+    size_t printedBytes = sink.count;
+    runner.run(spec.name, "tabulate", printed, printedBytes, [&] { df.head(printed); });
+    std::cout.rdbuf(console);
+
+    runner.run(spec.name, "pipeline", rows, csvBytes, [&] {
+        cdf::DataFrame frame = cdf::io::read_csv(csvPath);
+        frame = frame[cdf::col("i0") < threshold];
+        frame = frame[projected];
+        keep(frame[numeric].mean());
+    });
+
+    // Lazy plan with a limit before a filter, checked against the same steps run eagerly before being timed
+    size_t head = std::max<size_t>(1, rows / 2), kept = std::max<size_t>(1, rows / 3);
+    cdf::LazyFrame query =
+        df.lazy().limit(head).filter("i0", cdf::CompareOp::Less, threshold).select(projected).limit(kept);
+    if (runner.selected(spec.name, "lazy_query")) {
+        cdf::DataFrame lazy = query.collect();
+        cdf::DataFrame eager = df.iloc(0, head - 1);
+        eager = eager[cdf::col("i0") < threshold];
+        eager = eager[projected];
+        if (eager.shape().first > static_cast<int>(kept)) {
+            eager = eager.iloc(0, kept - 1);
+        }
+        if (!sameValues(lazy, eager, projected)) {
+            std::cerr << "lazy_query on " << spec.name << " differs from the eager steps\n";
+            std::exit(1);
+        }
+    }
+    runner.run(spec.name, "lazy_query", rows, frameBytes, [&] { keep(query.collect()); });
+
+    std::remove(csvPath.c_str());
+}
+
+const char* benchmarkNames[] = {"read_csv",          "filter_indices",    "filter_expression", "filter_mask",
+                                 "projection",        "iloc",              "append",            "snapshot_query",
+                                 "compare_int",       "compare_string",    "mode_string",       "isin",
+                                 "sum",               "mean",              "median",            "mode",
+                                 "rolling_mean",      "rolling_max",       "cumsum",            "tabulate",
+                                 "pipeline",          "lazy_query"};
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << "\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--json") {
+            options.json = true;
+        } else if (arg == "--filter") {
+            options.filter = value();
+        } else if (arg == "--scale") {
+            options.scale = std::stod(value());
+        } else if (arg == "--threads") {
+            options.threads = std::stoul(value());
+        } else if (arg == "--min-time") {
+            options.minTime = std::stod(value());
+        } else if (arg == "--tmp") {
+            options.tmpDir = value();
+        } else {
+            std::cerr << "Unknown option " << arg << "\n";
+            std::exit(2);
+        }
+    }
+    return options;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options = parseOptions(argc, argv);
+    if (options.threads > 0) {
+        cdf::set_num_threads(options.threads);
+    }
+
+    Runner runner(options);
+    for (auto& spec : {cdf::bench::tall(options.scale), cdf::bench::wide(options.scale),
+                       cdf::bench::textHeavy(options.scale), cdf::bench::nullHeavy(options.scale)}) {
+        // Datasets are only generated when one of their benchmarks is selected
+        bool selected = false;
+        for (auto& name : benchmarkNames) {
+            selected = selected || runner.selected(spec.name, name);
+        }
+        if (selected) {
+            benchDataset(runner, spec, options);
+        }
+    }
+    return 0;
+}
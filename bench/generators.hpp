@@ -0,0 +1,249 @@
+#ifndef BENCH_GENERATORS_HPP
+#define BENCH_GENERATORS_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../include/cdf.hpp"
+
+namespace cdf {
+
+/**
+ * @brief Deterministic synthetic datasets for the benchmarks.
+ *
+ * A dataset is fully described by a `DatasetSpec`, the same spec always produces the same values, in memory
+ * (`generate`) as well as in a CSV file (`writeCsv`).
+ */
+namespace bench {
+
+/**
+ * @brief splitmix64 generator, small and reproducible across platforms
+ */
+class Random {
+    uint64_t state;
+
+   public:
+    explicit Random(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        state += 0x9e3779b97f4a7c15ULL;
+        return mixHash(state);
+    }
+
+    /**
+     * @brief Uniform integer in [0, n)
+     */
+    uint64_t uniform(uint64_t n) { return next() % n; }
+
+    /**
+     * @brief Uniform double in [0, 1)
+     */
+    double real() { return (next() >> 11) * (1.0 / (1ULL << 53)); }
+};
+
+/**
+ * @brief Shape and value distribution of a synthetic dataset
+ */
+struct DatasetSpec {
+    std::string name;
+    size_t rows = 0;
+    size_t intColumns = 0;
+    size_t doubleColumns = 0;
+    size_t stringColumns = 0;
+    size_t stringLength = 8;   /**< Length of the generated strings */
+    size_t cardinality = 1000; /**< Number of distinct values per column */
+    double nullFraction = 0;   /**< Fraction of nan-values in every column */
+    uint64_t seed = 42;
+
+    size_t columns() const { return intColumns + doubleColumns + stringColumns; }
+};
+
+/**
+ * @brief Many columns, few rows
+ */
+DatasetSpec wide(double scale = 1) {
+    DatasetSpec spec;
+    spec.name = "wide";
+    spec.rows = 10000 * scale;
+    spec.intColumns = 100;
+    spec.doubleColumns = 80;
+    spec.stringColumns = 20;
+    return spec;
+}
+
+/**
+ * @brief Few columns, many rows
+ */
+DatasetSpec tall(double scale = 1) {
+    DatasetSpec spec;
+    spec.name = "tall";
+    spec.rows = 1000000 * scale;
+    spec.intColumns = 3;
+    spec.doubleColumns = 2;
+    spec.stringColumns = 1;
+    return spec;
+}
+
+/**
+ * @brief Long strings with a high cardinality, like log lines
+ */
+DatasetSpec textHeavy(double scale = 1) {
+    DatasetSpec spec;
+    spec.name = "text";
+    spec.rows = 200000 * scale;
+    spec.intColumns = 1;
+    spec.stringColumns = 4;
+    spec.stringLength = 64;
+    spec.cardinality = 50000;
+    return spec;
+}
+
+/**
+ * @brief Half of the values missing
+ */
+DatasetSpec nullHeavy(double scale = 1) {
+    DatasetSpec spec = tall(scale / 2);
+    spec.name = "nulls";
+    spec.nullFraction = 0.5;
+    return spec;
+}
+
+/**
+ * @brief Returns the column names of a dataset: i0.., d0.., s0..
+ */
+std::vector<std::string> columnNames(const DatasetSpec& spec) {
+    std::vector<std::string> names;
+    for (size_t j = 0; j < spec.intColumns; j++) {
+        names.push_back("i" + std::to_string(j));
+    }
+    for (size_t j = 0; j < spec.doubleColumns; j++) {
+        names.push_back("d" + std::to_string(j));
+    }
+    for (size_t j = 0; j < spec.stringColumns; j++) {
+        names.push_back("s" + std::to_string(j));
+    }
+    return names;
+}
+
+/**
+ * @brief Calls `emit(value)` for every cell of the dataset, row by row
+ */
+template <typename Emit, typename EndRow>
+void forEachCell(const DatasetSpec& spec, const Emit& emit, const EndRow& endRow) {
+    Random random(spec.seed);
+
+    // Dictionary of lowercase words shared by the string columns, so cardinality is controlled
+    std::vector<std::string> words(spec.cardinality);
+    for (auto& word : words) {
+        for (size_t k = 0; k < spec.stringLength; k++) {
+            word.push_back('a' + random.uniform(26));
+        }
+    }
+
+    for (size_t i = 0; i < spec.rows; i++) {
+        for (size_t j = 0; j < spec.columns(); j++) {
+            if (spec.nullFraction > 0 && random.real() < spec.nullFraction) {
+                emit(_cdfVal(NaN()));
+            } else if (j < spec.intColumns) {
+                emit(_cdfVal(static_cast<int>(random.uniform(spec.cardinality))));
+            } else if (j < spec.intColumns + spec.doubleColumns) {
+                emit(_cdfVal(random.uniform(spec.cardinality) + 0.25));
+            } else {
+                emit(_cdfVal(words[random.uniform(words.size())]));
+            }
+        }
+        endRow();
+    }
+}
+
+/**
+ * @brief Builds the dataset in memory
+ */
+DataFrame generate(const DatasetSpec& spec) {
+    DataFrameBuilder builder(columnNames(spec));
+    builder.reserve(spec.rows);
+    forEachCell(
+        spec,
+        [&](const _cdfVal& value) {
+            if (std::holds_alternative<int>(value)) {
+                builder.append_int(std::get<int>(value));
+            } else if (std::holds_alternative<double>(value)) {
+                builder.append_double(std::get<double>(value));
+            } else if (std::holds_alternative<std::string>(value)) {
+                builder.append_string(std::get<std::string>(value));
+            } else {
+                builder.append_null();
+            }
+        },
+        [] {});
+    return builder.build();
+}
+
+/**
+ * @brief Writes the dataset as a comma separated file with a header, nan-values as empty fields
+ *
+ * @returns The size of the file in bytes
+ * @throws std::runtime_error if the file cannot be written
+ */
+size_t writeCsv(const DatasetSpec& spec, const std::string& path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("[cdf][bench] Unable to write " + path);
+    }
+
+    std::string line;
+    std::vector<std::string> names = columnNames(spec);
+    for (size_t j = 0; j < names.size(); j++) {
+        line += (j ? "," : "") + names[j];
+    }
+    file << line << "\n";
+
+    size_t bytes = line.size() + 1;
+    bool first = true;
+    line.clear();
+    forEachCell(
+        spec,
+        [&](const _cdfVal& value) {
+            if (!first) {
+                line += ',';
+            }
+            first = false;
+            if (!std::holds_alternative<NaN>(value)) {
+                line += toString(value);
+            }
+        },
+        [&] {
+            line += '\n';
+            bytes += line.size();
+            file << line;
+            line.clear();
+            first = true;
+        });
+    return bytes;
+}
+
+/**
+ * @brief Number of payload bytes of a column: 4 per int, 8 per double, the length of each string
+ */
+size_t payloadBytes(const core::Series& series) {
+    size_t bytes = 0;
+    for (auto& value : series) {
+        if (std::holds_alternative<int>(value)) {
+            bytes += sizeof(int);
+        } else if (std::holds_alternative<double>(value)) {
+            bytes += sizeof(double);
+        } else if (std::holds_alternative<std::string>(value)) {
+            bytes += std::get<std::string>(value).size();
+        }
+    }
+    return bytes;
+}
+
+}  // namespace bench
+
+}  // namespace cdf
+
+#endif
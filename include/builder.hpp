@@ -0,0 +1,153 @@
+#ifndef BUILDER_HPP
+#define BUILDER_HPP
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "data.hpp"
+#include "dataframe.hpp"
+#include "dtypes.hpp"
+
+namespace cdf {
+
+/**
+ * @class DataFrameBuilder
+ * @brief Builds a DataFrame row by row, writing the values straight into their columns.
+ *
+ * Each column is a vector which, once reserved, takes every appended value without reallocating. `build()` hands
+ * the vectors over to the DataFrame without copying them.
+ *
+ * Example:
+ * ```
+ * cdf::DataFrameBuilder builder({"ID", "Name", "Salary"});
+ * builder.reserve(2);
+ * builder.emplace_row(1, "Alice", 75000.0);
+ * builder.append_int(2).append_string("Bob").append_null();
+ * cdf::DataFrame df = builder.build();
+ * ```
+ */
+class DataFrameBuilder {
+    std::vector<std::string> columns;
+    std::vector<std::vector<_cdfVal>> values;
+    size_t nextColumn = 0; /**< Column receiving the next appended value */
+    size_t rows = 0;       /**< Number of complete rows */
+
+    /**
+     * @brief Returns the column receiving the next value and moves on to the following one
+     */
+    std::vector<_cdfVal>& nextCell() {
+        if (values.empty()) {
+            throw std::length_error("[cdf][DataFrameBuilder] No column to append to");
+        }
+        std::vector<_cdfVal>& column = values[nextColumn];
+        if (++nextColumn == values.size()) {
+            nextColumn = 0;
+            ++rows;
+        }
+        return column;
+    }
+
+   public:
+    /**
+     * @brief Constructs a builder for the given columns.
+     *
+     * @param columns The column names of the DataFrame.
+     */
+    explicit DataFrameBuilder(std::vector<std::string> columns)
+        : columns(std::move(columns)), values(this->columns.size()) {}
+
+    /**
+     * @brief Makes room for a number of rows in every column.
+     *
+     * @param rows The total number of rows to make room for.
+     */
+    DataFrameBuilder& reserve(size_t rows) {
+        for (auto& column : values) {
+            column.reserve(rows);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Appends a row built in place from one value per column.
+     *
+     * @param rowValues The values of the row, anything a `_cdfVal` can be constructed from.
+     * @throws std::length_error if the number of values does not match the number of columns, or if a row is
+     * partially appended.
+     */
+    template <typename... Values>
+    DataFrameBuilder& emplace_row(Values&&... rowValues) {
+        if (nextColumn != 0) {
+            throw std::length_error("[cdf][DataFrameBuilder] Previous row is incomplete");
+        }
+        if (sizeof...(Values) != values.size()) {
+            throw std::length_error("[cdf][DataFrameBuilder] Row size not matching with column size");
+        }
+        size_t j = 0;
+        (values[j++].emplace_back(std::forward<Values>(rowValues)), ...);
+        ++rows;
+        return *this;
+    }
+
+    /**
+     * @brief Appends an integer to the current row.
+     */
+    DataFrameBuilder& append_int(int value) {
+        nextCell().emplace_back(value);
+        return *this;
+    }
+
+    /**
+     * @brief Appends a double to the current row.
+     */
+    DataFrameBuilder& append_double(double value) {
+        nextCell().emplace_back(value);
+        return *this;
+    }
+
+    /**
+     * @brief Appends a string to the current row, constructed in place from the view.
+     */
+    DataFrameBuilder& append_string(std::string_view value) {
+        nextCell().emplace_back(std::in_place_type<std::string>, value);
+        return *this;
+    }
+
+    /**
+     * @brief Appends a nan-value to the current row.
+     */
+    DataFrameBuilder& append_null() {
+        nextCell().emplace_back(NaN());
+        return *this;
+    }
+
+    /**
+     * @brief Returns the number of complete rows.
+     */
+    size_t size() const { return rows; }
+
+    /**
+     * @brief Moves the columns into a DataFrame, the builder is left without rows.
+     *
+     * @throws std::length_error if the last row is partially appended.
+     */
+    DataFrame build() {
+        if (nextColumn != 0) {
+            throw std::length_error("[cdf][DataFrameBuilder] Last row is incomplete");
+        }
+        core::Data data;
+        for (auto& column : values) {
+            data.addColumn(std::move(column));
+            column = std::vector<_cdfVal>();
+        }
+        rows = 0;
+        return DataFrame(std::move(data), columns);
+    }
+};
+
+}  // namespace cdf
+
+#endif
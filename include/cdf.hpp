@@ -1,3 +1,16 @@
+#include "builder.hpp"
+#include "compression.hpp"
 #include "dataframe.hpp"
 #include "dtypes.hpp"
+#include "encoding.hpp"
+#include "index.hpp"
 #include "input.hpp"
+#include "lazy.hpp"
+#include "live.hpp"
+#include "memory.hpp"
+#include "parallel.hpp"
+#include "sketch.hpp"
+#include "strings.hpp"
+#include "trace.hpp"
+#include "window.hpp"
+#include "zonemap.hpp"
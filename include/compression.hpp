@@ -0,0 +1,284 @@
+#ifndef COMPRESSION_HPP
+#define COMPRESSION_HPP
+
+#include <algorithm>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#ifdef CDF_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef CDF_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace cdf {
+namespace io {
+
+/**
+ * @brief Compression formats recognized in input files.
+ */
+enum class Compression { None, Gzip, Zstd };
+
+/**
+ * @brief Detects the compression of a file from its first bytes, whatever its name.
+ *
+ * @param file The file, read from its start, which is sought back to the start.
+ * @return `Compression::Gzip` for the gzip magic bytes `1f 8b`, `Compression::Zstd` for `28 b5 2f fd`, otherwise
+ * `Compression::None`.
+ */
+Compression detectCompression(std::streambuf& file) {
+    unsigned char magic[4] = {0, 0, 0, 0};
+    std::streamsize read = file.sgetn(reinterpret_cast<char*>(magic), sizeof(magic));
+    file.pubseekpos(0, std::ios::in);
+    if (read >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+        return Compression::Gzip;
+    }
+    if (read == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+        return Compression::Zstd;
+    }
+    return Compression::None;
+}
+
+/**
+ * @class DecompressingBuffer
+ * @brief Stream buffer decompressing a compressed file as it is read, one buffer at a time.
+ *
+ * Only a buffer of compressed input and a buffer of decompressed output are held, the decompressed file is never
+ * materialized. Large reads are decompressed straight into the destination. Corrupted or truncated input raises a
+ * std::runtime_error.
+ */
+class DecompressingBuffer : public std::streambuf {
+   protected:
+    static constexpr size_t bufferBytes = 1 << 16;
+
+    std::streambuf& source;
+    std::string path;
+    std::vector<char> input;
+    std::vector<char> output;
+    bool sourceDone = false;
+
+    /**
+     * @brief Reads the next compressed bytes into `input`, returns how many were read.
+     */
+    size_t refill() {
+        std::streamsize read = source.sgetn(input.data(), input.size());
+        sourceDone = read <= 0;
+        return sourceDone ? 0 : static_cast<size_t>(read);
+    }
+
+    /**
+     * @brief Decompresses up to `capacity` bytes into `destination`, returns how many, 0 at the end of the file.
+     */
+    virtual size_t decompress(char* destination, size_t capacity) = 0;
+
+    [[noreturn]] void fail(const std::string& reason) const {
+        throw std::runtime_error("[cdf][io] Unable to decompress " + path + ": " + reason);
+    }
+
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        size_t produced = decompress(output.data(), output.size());
+        if (produced == 0) {
+            return traits_type::eof();
+        }
+        setg(output.data(), output.data(), output.data() + produced);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    std::streamsize xsgetn(char* destination, std::streamsize count) override {
+        std::streamsize copied = std::min<std::streamsize>(count, egptr() - gptr());
+        std::copy(gptr(), gptr() + copied, destination);
+        gbump(static_cast<int>(copied));
+        while (copied < count) {
+            size_t produced = decompress(destination + copied, count - copied);
+            if (produced == 0) {
+                break;
+            }
+            copied += produced;
+        }
+        return copied;
+    }
+
+   public:
+    DecompressingBuffer(std::streambuf& source, std::string path)
+        : source(source), path(std::move(path)), input(bufferBytes), output(bufferBytes) {
+        setg(output.data(), output.data(), output.data());
+    }
+
+    DecompressingBuffer(const DecompressingBuffer&) = delete;
+    DecompressingBuffer& operator=(const DecompressingBuffer&) = delete;
+};
+
+#ifdef CDF_WITH_ZLIB
+/**
+ * @class GzipBuffer
+ * @brief Decompresses a gzip file, concatenated members included (as written by `cat a.gz b.gz`).
+ */
+class GzipBuffer : public DecompressingBuffer {
+    z_stream stream{};
+    bool memberEnded = false;
+
+    size_t decompress(char* destination, size_t capacity) override {
+        stream.next_out = reinterpret_cast<Bytef*>(destination);
+        stream.avail_out = static_cast<uInt>(std::min<size_t>(capacity, 1u << 30));
+        uInt requested = stream.avail_out;
+        while (stream.avail_out > 0) {
+            if (stream.avail_in == 0 && !sourceDone) {
+                stream.avail_in = static_cast<uInt>(refill());
+                stream.next_in = reinterpret_cast<Bytef*>(input.data());
+            }
+            if (memberEnded) {
+                if (stream.avail_in == 0) {
+                    break;
+                }
+                inflateReset(&stream);
+                memberEnded = false;
+            }
+            int status = inflate(&stream, Z_NO_FLUSH);
+            if (status == Z_STREAM_END) {
+                memberEnded = true;
+            } else if (status == Z_BUF_ERROR && sourceDone) {
+                fail("truncated gzip stream");
+            } else if (status != Z_OK && status != Z_BUF_ERROR) {
+                fail(stream.msg ? stream.msg : "corrupted gzip stream");
+            }
+        }
+        return requested - stream.avail_out;
+    }
+
+   public:
+    GzipBuffer(std::streambuf& source, std::string path) : DecompressingBuffer(source, std::move(path)) {
+        // 15 + 16: window of 32KiB, gzip header expected
+        if (inflateInit2(&stream, 15 + 16) != Z_OK) {
+            fail("zlib initialization failed");
+        }
+    }
+
+    ~GzipBuffer() override { inflateEnd(&stream); }
+};
+#endif
+
+#ifdef CDF_WITH_ZSTD
+/**
+ * @class ZstdBuffer
+ * @brief Decompresses a zstd file, made of one or several frames.
+ */
+class ZstdBuffer : public DecompressingBuffer {
+    ZSTD_DStream* stream;
+    ZSTD_inBuffer pending{nullptr, 0, 0};
+    bool frameOpen = false;
+
+    size_t decompress(char* destination, size_t capacity) override {
+        ZSTD_outBuffer out{destination, capacity, 0};
+        while (out.pos < out.size) {
+            if (pending.pos == pending.size && !sourceDone) {
+                pending = {input.data(), refill(), 0};
+            }
+            size_t consumed = pending.pos, produced = out.pos;
+            size_t status = ZSTD_decompressStream(stream, &out, &pending);
+            if (ZSTD_isError(status)) {
+                fail(ZSTD_getErrorName(status));
+            }
+            if (pending.pos == consumed && out.pos == produced) {
+                // No progress: the input is exhausted
+                if (frameOpen) {
+                    fail("truncated zstd stream");
+                }
+                break;
+            }
+            frameOpen = status != 0;
+        }
+        return out.pos;
+    }
+
+   public:
+    ZstdBuffer(std::streambuf& source, std::string path)
+        : DecompressingBuffer(source, std::move(path)), stream(ZSTD_createDStream()) {
+        if (!stream) {
+            fail("zstd initialization failed");
+        }
+        ZSTD_initDStream(stream);
+    }
+
+    ~ZstdBuffer() override { ZSTD_freeDStream(stream); }
+};
+#endif
+
+/**
+ * @class InputFile
+ * @brief Input stream over a file which may be compressed, detected from its first bytes.
+ *
+ * Plain files are read as with std::ifstream. Gzip and zstd files are decompressed while they are read, which needs
+ * zlib, respectively libzstd: define `CDF_WITH_ZLIB` and/or `CDF_WITH_ZSTD` before including cdf and link the library
+ * (`-lz`, `-lzstd`). Without them, opening a compressed file throws.
+ *
+ * Errors raised while decompressing set the badbit, which is reported by throwing a std::runtime_error.
+ */
+class InputFile : public std::istream {
+    std::filebuf file;
+    std::unique_ptr<std::streambuf> decoder;
+    Compression kind = Compression::None;
+
+   public:
+    /**
+     * @brief Opens a file, the stream is in a failed state if it cannot be opened.
+     *
+     * @param path The path to the file.
+     * @param mode The mode to open a plain file with, compressed files are always read as binary.
+     * @throws std::runtime_error If the file is compressed in a format this build does not decompress.
+     */
+    explicit InputFile(const std::string& path, std::ios::openmode mode = std::ios::in) : std::istream(nullptr) {
+        rdbuf(&file);
+        if (!file.open(path, mode | std::ios::in | std::ios::binary)) {
+            setstate(std::ios::failbit);
+            return;
+        }
+        kind = detectCompression(file);
+        if (kind == Compression::Gzip) {
+#ifdef CDF_WITH_ZLIB
+            decoder.reset(new GzipBuffer(file, path));
+#else
+            throw std::runtime_error("[cdf][io] " + path +
+                                     " is gzip compressed, define CDF_WITH_ZLIB and link zlib to read it");
+#endif
+        } else if (kind == Compression::Zstd) {
+#ifdef CDF_WITH_ZSTD
+            decoder.reset(new ZstdBuffer(file, path));
+#else
+            throw std::runtime_error("[cdf][io] " + path +
+                                     " is zstd compressed, define CDF_WITH_ZSTD and link libzstd to read it");
+#endif
+        } else if (!(mode & std::ios::binary)) {
+            // Plain files keep the requested text mode
+            file.close();
+            if (!file.open(path, mode | std::ios::in)) {
+                setstate(std::ios::failbit);
+                return;
+            }
+        }
+        if (decoder) {
+            rdbuf(decoder.get());
+        }
+        exceptions(std::ios::badbit);
+    }
+
+    bool is_open() const { return file.is_open(); }
+
+    /**
+     * @brief Returns the compression detected when the file was opened.
+     */
+    Compression compression() const { return kind; }
+};
+
+}  // namespace io
+}  // namespace cdf
+
+#endif
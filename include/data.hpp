@@ -1,13 +1,33 @@
 #ifndef DATA_HPP
 #define DATA_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "dtypes.hpp"
+#include "encoding.hpp"
+#include "hashtable.hpp"
+#include "index.hpp"
+#include "kernels.hpp"
+#include "memory.hpp"
+#include "parallel.hpp"
+#include "strings.hpp"
+#include "trace.hpp"
 #include "utils.hpp"
+#include "window.hpp"
+#include "zonemap.hpp"
 
 namespace cdf {
 
+class DataFrame;
+
 namespace core {
 
 /**
@@ -19,6 +39,8 @@ namespace core {
 class Row {
     std::vector<_cdfVal> _row;
 
+    friend class Data;
+
    public:
     /**
      * @brief Constructs a Row object from a vector of data.
@@ -26,12 +48,20 @@ class Row {
      * @param inputRow A vector of data values to populate the row with.
      */
     template <typename T>
-    Row(std::vector<T> inputRow) {
+    Row(const std::vector<T>& inputRow) {
+        _row.reserve(inputRow.size());
         for (auto& it : inputRow) {
             _row.push_back(it);
         }
     }
 
+    /**
+     * @brief Constructs a Row object taking over a vector of values, nothing is copied.
+     *
+     * @param inputRow A vector of data values to populate the row with.
+     */
+    Row(std::vector<_cdfVal>&& inputRow) : _row(std::move(inputRow)) {}
+
     /**
      * @brief Returns the size of the row.
      *
@@ -55,366 +85,1727 @@ class Row {
 };
 
 /**
- * @class Series
- * @brief A class that represents a series of heterogeneous data values and provides comparison utilities.
+ * @brief Compares the string representation of a value with a given string using a custom comparator.
  *
- * The Series class stores a sequence of values of type `_cdfVal` (which can hold multiple types, such as int, double,
- * or std::string) and allows comparisons between the series elements and a provided value using standard comparison
- * operators (e.g., ==, <, <=, >, >=, !=).
+ * @param rowVal The value to compare.
+ * @param val The string value to compare against.
+ * @param op The comparator function to use for the comparison.
+ * @return The result of the comparison, false for nan-values.
  */
-class Series {
-    std::vector<_cdfVal> series;
+template <typename Comparator>
+bool compareValue(const _cdfVal& rowVal, const std::string& val, const Comparator& op) {
+    return std::visit(
+        [&](const auto& v) -> bool {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, int>) {
+                return op(to_string(v), val);
+            } else if constexpr (std::is_same_v<T, double>) {
+                return op(to_string(v), val);
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                return op(v, val);
+            } else {
+                return false;  // Handle cdf::NaN or mismatched types
+            }
+        },
+        rowVal);
+}
+
+/**
+ * @brief Compares a numeric value with a given integer using a custom comparator.
+ *
+ * @param rowVal The value to compare.
+ * @param val The integer value to compare against.
+ * @param op The comparator function to use for the comparison.
+ * @return The result of the comparison, false for nan-values and strings.
+ */
+template <typename Comparator>
+bool compareValue(const _cdfVal& rowVal, int val, const Comparator& op) {
+    if (std::holds_alternative<int>(rowVal)) {
+        return op(std::get<int>(rowVal), val);
+    } else if (std::holds_alternative<double>(rowVal)) {
+        return op(std::get<double>(rowVal), static_cast<double>(val));
+    }
+    return false;  // Handle cdf::NaN, strings, or mismatched types
+}
+
+/**
+ * @brief Compares a numeric value with a given double using a custom comparator.
+ *
+ * @param rowVal The value to compare.
+ * @param val The double value to compare against.
+ * @param op The comparator function to use for the comparison.
+ * @return The result of the comparison, false for nan-values and strings.
+ */
+template <typename Comparator>
+bool compareValue(const _cdfVal& rowVal, double val, const Comparator& op) {
+    if (std::holds_alternative<double>(rowVal)) {
+        return op(std::get<double>(rowVal), val);
+    } else if (std::holds_alternative<int>(rowVal)) {
+        return op(static_cast<double>(std::get<int>(rowVal)), val);
+    }
+    return false;  // Handle cdf::NaN, strings, or mismatched types
+}
+
+/**
+ * @brief Returns the bytes a value holds outside of its variant slot: the heap block of a string too long for the
+ * small string buffer, nothing for the other types
+ */
+size_t heapBytes(const _cdfVal& value) {
+    if (!std::holds_alternative<std::string>(value)) {
+        return 0;
+    }
+    const std::string& text = std::get<std::string>(value);
+    const char* object = reinterpret_cast<const char*>(&text);
+    bool inlined = text.data() >= object && text.data() < object + sizeof(std::string);
+    return inlined ? 0 : text.capacity() + 1;
+}
+
+/**
+ * @class ColumnBuffer
+ * @brief The values of a column, shared between DataFrames and Series.
+ *
+ * Alongside the values, a buffer keeps the representations derived from them: the typed buffer of numeric columns
+ * and the compact string headers of string columns, the secondary indexes and the zone map. Each is built on first use
+ * and reused by every owner of the buffer, modifying the values drops them. Appending a value keeps the zone map up to
+ * date, a buffer filled by appends starting empty has one from its first value.
+ *
+ * A buffer may hold its values encoded instead (see `Encoding`). Comparisons, sums and counts then read the encoded
+ * form, the typed representation is decoded from it directly, and the variants are only decoded, once, by the first
+ * access to `values()`.
+ *
+ * A buffer may also chain immutable chunks, other buffers shared without copying (see `appendChunk`). Comparisons
+ * run chunk by chunk and the typed representation is concatenated from the typed chunks. Rows are read from the chunk
+ * holding them, see `at` and `forEachValue`, only `values()` gathers the chunks into one vector.
+ */
+class ColumnBuffer {
+    mutable std::vector<_cdfVal> _values; /**< Decoded or gathered on first access when encoded or chunked */
+    std::shared_ptr<const EncodedColumn> encoded;
+    std::vector<std::shared_ptr<const ColumnBuffer>> chunkBuffers;
+    std::vector<size_t> chunkStarts; /**< Row of the buffer each chunk starts at */
+    size_t chunkedRows = 0;
+    mutable std::atomic<bool> decoded{true}; /**< Whether _values holds the values */
+    mutable std::mutex decodeMutex;
+    mutable std::mutex cacheMutex;
+    mutable std::shared_ptr<const kernels::TypedColumn> typedCache;
+    mutable std::shared_ptr<const StringColumn> stringCache;
+    mutable bool stringChecked = false; /**< Whether stringCache was looked for, it stays empty for numeric columns */
+    mutable std::shared_ptr<const ColumnIndex> hashIndex;
+    mutable std::shared_ptr<const ColumnIndex> sortedIndex;
+    mutable std::shared_ptr<ZoneMap> zoneCache; /**< Only modified by the sole owner of the buffer, on append */
+    bool writable = false; /**< Whether the buffer was made by `create`, see `owned` */
+
+    std::shared_ptr<const ColumnIndex>& indexSlot(IndexKind kind) const {
+        return kind == IndexKind::Hash ? hashIndex : sortedIndex;
+    }
 
     /**
-     * @brief Compares each string representation of elements in the series with a given string using a custom
-     * comparator.
-     *
-     * @tparam Comparator The type of the comparator function.
-     * @param val The string value to compare against.
-     * @param op The comparator function to use for the comparison.
-     * @return A vector of boolean values indicating the result of the comparison for each element in the series.
+     * @brief Drops the derived representations, the zone map too unless asked to keep it
      */
-    template <typename Comparator>
-    std::vector<bool> compareString(const std::string& val, const Comparator& op) const {
-        std::vector<bool> truth;
-        for (const auto& rowVal : series) {
-            truth.push_back(std::visit(
-                [&](const auto& v) -> bool {
-                    using T = std::decay_t<decltype(v)>;
-                    if constexpr (std::is_same_v<T, int>) {
-                        return op(to_string(v), val);
-                    } else if constexpr (std::is_same_v<T, double>) {
-                        return op(to_string(v), val);
-                    } else if constexpr (std::is_same_v<T, std::string>) {
-                        return op(v, val);
-                    } else {
-                        return false;  // Handle cdf::NaN or mismatched types
-                    }
-                },
-                rowVal));
+    void dropDerived(bool keepZoneMap) {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        typedCache.reset();
+        stringCache.reset();
+        stringChecked = false;
+        hashIndex.reset();
+        sortedIndex.reset();
+        if (!keepZoneMap) {
+            zoneCache.reset();
         }
-        return truth;
     }
 
     /**
-     * @brief Compares each integer element in the series with a given integer using a custom comparator.
+     * @brief Returns the last chunk for modification if `rows` more rows keep it under `chunkRows`, nullptr
+     * otherwise. A chunk shared, or adopted from a caller, is copied first, see `owned`.
+     */
+    ColumnBuffer* smallTail(size_t rows) {
+        if (chunkBuffers.empty() || chunkBuffers.back()->size() + rows > chunkRows) {
+            return nullptr;
+        }
+        ColumnBuffer* tail = &owned(chunkBuffers.back());
+        tail->values();
+        tail->encoded.reset();
+        size_t needed = tail->_values.size() + rows;
+        if (needed > tail->_values.capacity()) {
+            // Capacity doubles up to chunkRows, a full chunk has no spare slots
+            tail->_values.reserve(std::min(chunkRows, std::max(needed, 2 * tail->_values.capacity())));
+        }
+        return tail;
+    }
+
+    /**
+     * @brief Adds a chunk after the last one, starting at row `chunkedRows`
+     */
+    void pushChunk(std::shared_ptr<const ColumnBuffer> chunk) {
+        chunkStarts.push_back(chunkedRows);
+        chunkBuffers.push_back(std::move(chunk));
+    }
+
+    /**
+     * @brief Drops the gathered values and the derived representations after chunks were appended
+     */
+    void chunksChanged() {
+        decoded = false;
+        std::vector<_cdfVal>().swap(_values);
+        dropDerived(false);
+    }
+
+   public:
+    static constexpr size_t chunkRows = 1 << 16; /**< Smaller appended chunks are merged up to this size */
+
+    ColumnBuffer() = default;
+
+    /**
+     * @brief Constructs a buffer taking over the given values.
+     */
+    explicit ColumnBuffer(std::vector<_cdfVal> values) : _values(std::move(values)) {}
+
+    /**
+     * @brief Constructs a buffer holding encoded values.
+     */
+    explicit ColumnBuffer(std::shared_ptr<const EncodedColumn> encoded) : encoded(std::move(encoded)), decoded(false) {}
+
+    /**
+     * @brief Constructs a buffer chaining the values of other buffers, which are shared, not copied.
+     */
+    explicit ColumnBuffer(const std::vector<std::shared_ptr<const ColumnBuffer>>& parts) {
+        for (auto& part : parts) {
+            appendChunk(part);
+        }
+    }
+
+    /**
+     * @brief Makes a buffer which its sole owner may modify in place, see `owned`.
+     */
+    template <typename... Args>
+    static std::shared_ptr<ColumnBuffer> create(Args&&... args) {
+        auto buffer = std::make_shared<ColumnBuffer>(std::forward<Args>(args)...);
+        buffer->writable = true;
+        return buffer;
+    }
+
+    /**
+     * @brief Returns the buffer held by `slot` for modification, replacing it by a copy first if it is shared or was
+     * not made by `create`.
      *
-     * @tparam Comparator The type of the comparator function.
-     * @param val The integer value to compare against.
-     * @param op The comparator function to use for the comparison.
-     * @return A vector of boolean values indicating the result of the comparison for each element in the series.
+     * Buffers are handed around as pointers to const, a buffer made with `std::make_shared<const ColumnBuffer>` is a
+     * const object and must never be modified, so only the buffers made by `create` are modified in place.
      */
-    template <typename Comparator>
-    std::vector<bool> compareInt(int val, const Comparator& op) const {
-        std::vector<bool> truth;
-        for (const auto& rowVal : series) {
-            truth.push_back(std::visit(
-                [&](const auto& v) -> bool {
-                    using T = std::decay_t<decltype(v)>;
-                    if constexpr (std::is_same_v<T, int>) {
-                        return op(v, val);
-                    } else if constexpr (std::is_same_v<T, double>) {
-                        return op(v, static_cast<double>(val));
-                    } else {
-                        return false;  // Handle cdf::NaN, strings, or mismatched types
-                    }
-                },
-                rowVal));
+    static ColumnBuffer& owned(std::shared_ptr<const ColumnBuffer>& slot) {
+        if (slot.use_count() != 1 || !slot->writable) {
+            slot = create(*slot);
         }
-        return truth;
+        // create() makes non-const objects, modifying one through the sole reference to it is well defined
+        return const_cast<ColumnBuffer&>(*slot);
     }
 
     /**
-     * @brief Compares each double element in the series with a given double using a custom comparator.
+     * @brief Copies the values and the zone map, so appends to the copy keep it, other derived representations are
+     * rebuilt on demand. Encoded values and chunks are shared, not decoded.
+     */
+    ColumnBuffer(const ColumnBuffer& other)
+        : encoded(other.encoded),
+          chunkBuffers(other.chunkBuffers),
+          chunkStarts(other.chunkStarts),
+          chunkedRows(other.chunkedRows) {
+        if (other.chunked()) {
+            decoded = false;
+            return;
+        }
+        if (encoded && !other.decoded.load(std::memory_order_acquire)) {
+            decoded = false;
+        } else {
+            _values = other._values;
+        }
+        std::lock_guard<std::mutex> lock(other.cacheMutex);
+        if (other.zoneCache) {
+            zoneCache = std::make_shared<ZoneMap>(*other.zoneCache);
+        }
+    }
+
+    /**
+     * @brief Returns the values, decoding them on first access if the buffer is encoded.
      *
-     * @tparam Comparator The type of the comparator function.
-     * @param val The double value to compare against.
-     * @param op The comparator function to use for the comparison.
-     * @return A vector of boolean values indicating the result of the comparison for each element in the series.
+     * A chunked buffer gathers its chunks into one vector, copied again after every append: reading rows with `at`
+     * or `forEachValue` does not.
      */
-    template <typename Comparator>
-    std::vector<bool> compareDouble(double val, const Comparator& op) const {
-        std::vector<bool> truth;
-        for (const auto& rowVal : series) {
-            truth.push_back(std::visit(
-                [&](const auto& v) -> bool {
-                    using T = std::decay_t<decltype(v)>;
-                    if constexpr (std::is_same_v<T, double>) {
-                        return op(v, val);
-                    } else if constexpr (std::is_same_v<T, int>) {
-                        return op(static_cast<double>(v), val);
-                    } else {
-                        return false;  // Handle cdf::NaN, strings, or mismatched types
+    const std::vector<_cdfVal>& values() const {
+        if (!decoded.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(decodeMutex);
+            if (!decoded.load(std::memory_order_relaxed)) {
+                if (encoded) {
+                    CDF_TRACE_PHASE(span, "Series::decode");
+                    span.rowsIn(encoded->size());
+                    _values = encoded->decode();
+                } else {
+                    CDF_TRACE_PHASE(span, "Series::gather_chunks");
+                    span.rowsIn(chunkedRows);
+                    _values.reserve(chunkedRows);
+                    for (auto& chunk : chunkBuffers) {
+                        _values.insert(_values.end(), chunk->values().begin(), chunk->values().end());
                     }
-                },
-                rowVal));
+                }
+                decoded.store(true, std::memory_order_release);
+            }
         }
-        return truth;
+        return _values;
     }
 
     /**
-     * @brief Compares elements in the series with a given value using a custom comparator.
+     * @brief Returns whether the buffer chains chunks, see `chunks()`.
+     */
+    bool chunked() const { return !chunkBuffers.empty(); }
+
+    /**
+     * @brief Returns the chunks of a chunked buffer, in order, empty otherwise.
+     */
+    const std::vector<std::shared_ptr<const ColumnBuffer>>& chunks() const { return chunkBuffers; }
+
+    /**
+     * @brief Returns the index of the chunk holding a row of a chunked buffer, by binary search on the chunk starts.
+     */
+    size_t chunkOf(size_t row) const {
+        return std::upper_bound(chunkStarts.begin(), chunkStarts.end(), row) - chunkStarts.begin() - 1;
+    }
+
+    /**
+     * @brief Returns the value of a row without bounds checking, a chunked buffer reads it from the chunk holding it.
+     */
+    const _cdfVal& at(size_t row) const {
+        if (chunked()) {
+            size_t chunk = chunkOf(row);
+            return chunkBuffers[chunk]->values()[row - chunkStarts[chunk]];
+        }
+        return values()[row];
+    }
+
+    /**
+     * @brief Calls `f(row, value)` for every row in [begin, end), chunk after chunk for a chunked buffer.
+     */
+    template <typename F>
+    void forEachValue(size_t begin, size_t end, const F& f) const {
+        if (!chunked()) {
+            const std::vector<_cdfVal>& flat = values();
+            for (size_t i = begin; i < end; i++) {
+                f(i, flat[i]);
+            }
+            return;
+        }
+        for (size_t chunk = chunkOf(begin); begin < end; chunk++) {
+            const std::vector<_cdfVal>& part = chunkBuffers[chunk]->values();
+            size_t start = chunkStarts[chunk];
+            size_t stop = std::min(end, start + part.size());
+            for (; begin < stop; begin++) {
+                f(begin, part[begin - start]);
+            }
+        }
+    }
+
+    /**
+     * @brief Tells whether the values hold strings and whether they hold numbers, without decoding encoded values.
      *
-     * This method routes to the appropriate compare function (compareString, compareInt, or compareDouble) based on
-     * the type of the provided value.
+     * Integer encodings only hold integers and nan-values, run-length encodings are told by their runs.
+     */
+    void valueKinds(bool& hasStrings, bool& hasNumbers) const {
+        if (chunked()) {
+            for (auto& chunk : chunkBuffers) {
+                chunk->valueKinds(hasStrings, hasNumbers);
+            }
+            return;
+        }
+        if (encoded && encoded->encoding() != Encoding::RunLength) {
+            hasNumbers |= encoded->nullCount() < encoded->size();
+            return;
+        }
+        for (auto& value : encoded ? encoded->runs() : values()) {
+            hasStrings |= std::holds_alternative<std::string>(value);
+            hasNumbers |= std::holds_alternative<int>(value) || std::holds_alternative<double>(value);
+        }
+    }
+
+    /**
+     * @brief Appends the values of another buffer as a chunk, turning this buffer into a chunked one.
      *
-     * @tparam T The type of the value to compare.
-     * @tparam Comparator The type of the comparator function.
-     * @param value The value to compare against.
-     * @param op The comparator function to use for the comparison.
-     * @return A vector of boolean values indicating the result of the comparison for each element in the series.
+     * The values already held are never moved: plain or encoded values become the first chunk, and chunks are only
+     * ever added after the last one. A chunk smaller than `chunkRows` is merged into a small last chunk instead, so
+     * appending small batches does not pile up chunks. The chunks of a chunked buffer are appended one by one.
      */
-    template <typename T, typename Comparator>
-    std::vector<bool> compare(const T& value, const Comparator& op) {
-        if constexpr (std::is_same_v<T, std::string>) {
-            return compareString(value, op);
-        } else if constexpr (std::is_same_v<T, int>) {
-            return compareInt(value, op);
-        } else if constexpr (std::is_same_v<T, double>) {
-            return compareDouble(value, op);
+    void appendChunk(std::shared_ptr<const ColumnBuffer> part) {
+        if (part->chunked()) {
+            for (auto& chunk : part->chunks()) {
+                appendChunk(chunk);
+            }
+            return;
+        }
+        size_t rows = part->size();
+        if (rows == 0) {
+            return;
+        }
+        if (!chunked() && size() > 0) {
+            auto first = create(std::move(_values));
+            first->encoded = std::move(encoded);
+            first->decoded = decoded.load();
+            std::lock_guard<std::mutex> lock(cacheMutex);
+            first->typedCache = std::move(typedCache);
+            first->zoneCache = std::move(zoneCache);
+            size_t firstRows = first->size();
+            pushChunk(std::move(first));
+            chunkedRows = firstRows;
+        }
+        encoded.reset();
+        if (ColumnBuffer* tail = smallTail(rows)) {
+            tail->dropDerived(true);
+            std::lock_guard<std::mutex> lock(tail->cacheMutex);
+            for (auto& value : part->values()) {
+                if (tail->zoneCache) {
+                    tail->zoneCache->append(value);
+                }
+                tail->_values.push_back(value);
+            }
         } else {
-            std::cout << "Unknown data-type found\n";
-            std::vector<bool> truth(series.size(), false);
-            return truth;
+            pushChunk(std::move(part));
+        }
+        chunkedRows += rows;
+        chunksChanged();
+    }
+
+    /**
+     * @brief Returns the encoded values, nullptr for plain buffers.
+     */
+    const EncodedColumn* encodedColumn() const { return encoded.get(); }
+
+    /**
+     * @brief Returns the encoding of the values.
+     */
+    Encoding encoding() const { return encoded ? encoded->encoding() : Encoding::Plain; }
+
+    /**
+     * @brief Returns the values for modification, dropping the derived representations, the encoding and the chunks.
+     */
+    std::vector<_cdfVal>& mutableValues() {
+        values();
+        encoded.reset();
+        chunkBuffers.clear();
+        chunkStarts.clear();
+        chunkedRows = 0;
+        dropDerived(false);
+        return _values;
+    }
+
+    /**
+     * @brief Adds a value after the last one, dropping the derived representations but the zone map, which is
+     * extended with the value. A chunked buffer adds it to its last chunk, or to a new one once the last one holds
+     * `chunkRows` values.
+     */
+    void append(_cdfVal value) {
+        if (chunked()) {
+            ColumnBuffer* tail = smallTail(1);
+            if (!tail) {
+                pushChunk(create());
+                tail = smallTail(1);
+            }
+            tail->append(std::move(value));
+            chunkedRows++;
+            chunksChanged();
+            return;
+        }
+        values();
+        encoded.reset();
+        dropDerived(true);
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (!zoneCache && _values.empty()) {
+            zoneCache = std::make_shared<ZoneMap>();
+        }
+        if (zoneCache) {
+            zoneCache->append(value);
+        }
+        _values.push_back(std::move(value));
+    }
+
+    /**
+     * @brief Returns the number of values.
+     */
+    size_t size() const { return encoded ? encoded->size() : chunked() ? chunkedRows : _values.size(); }
+
+    /**
+     * @brief Returns the bytes held by the buffer.
+     *
+     * @param deep Also counts the heap blocks of long strings and the typed and string representations built so far,
+     * otherwise only the variant slots, unused capacity included, and the encoded values.
+     */
+    size_t memoryBytes(bool deep) const {
+        bool plain = decoded.load(std::memory_order_acquire);
+        size_t bytes = sizeof(ColumnBuffer) + (plain ? _values.capacity() * sizeof(_cdfVal) : 0);
+        if (encoded) {
+            bytes += sizeof(EncodedColumn) + encoded->memoryBytes();
+        }
+        bytes += chunkBuffers.capacity() * sizeof(chunkBuffers[0]) + chunkStarts.capacity() * sizeof(size_t);
+        for (auto& chunk : chunkBuffers) {
+            bytes += chunk->memoryBytes(deep);
+        }
+        if (!deep) {
+            return bytes;
+        }
+        if (plain) {
+            for (auto& value : _values) {
+                bytes += heapBytes(value);
+            }
+        }
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (typedCache) {
+            bytes += sizeof(kernels::TypedColumn) + typedCache->memoryBytes();
+        }
+        if (stringCache) {
+            bytes += sizeof(StringColumn) + stringCache->memoryBytes();
+        }
+        for (auto* index : {&hashIndex, &sortedIndex}) {
+            if (*index) {
+                bytes += sizeof(ColumnIndex) + (*index)->memoryBytes();
+            }
+        }
+        if (zoneCache) {
+            bytes += sizeof(ZoneMap) + zoneCache->memoryBytes();
+        }
+        return bytes;
+    }
+
+    /**
+     * @brief Returns the values as a typed buffer, materialized on first use. A chunked buffer concatenates the typed
+     * buffers of its chunks.
+     *
+     * @throws std::runtime_error if string type field is found
+     */
+    const kernels::TypedColumn& typed() const {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (!typedCache) {
+            CDF_TRACE_PHASE(span, "Series::materialize_typed");
+            span.rowsIn(size());
+            if (chunked()) {
+                std::vector<const kernels::TypedColumn*> parts;
+                for (auto& chunk : chunkBuffers) {
+                    parts.push_back(&chunk->typed());
+                }
+                typedCache = std::make_shared<const kernels::TypedColumn>(kernels::concatTyped(parts));
+            } else {
+                typedCache = std::make_shared<const kernels::TypedColumn>(encoded ? encoded->toTyped()
+                                                                                  : kernels::toTypedColumn(_values));
+            }
+        }
+        return *typedCache;
+    }
+
+    /**
+     * @brief Stores a typed buffer known to match the values, so it is not materialized again.
+     */
+    void setTyped(kernels::TypedColumn column) {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        typedCache = std::make_shared<const kernels::TypedColumn>(std::move(column));
+    }
+
+    /**
+     * @brief Returns the compact string representation, built on first use.
+     *
+     * @return The string column, nullptr if the column holds numbers.
+     */
+    const StringColumn* strings() const {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (!stringChecked) {
+            CDF_TRACE_PHASE(span, "Series::materialize_strings");
+            span.rowsIn(values().size());
+            stringChecked = true;
+            bool numeric = std::any_of(values().begin(), values().end(), [](const _cdfVal& value) {
+                return std::holds_alternative<int>(value) || std::holds_alternative<double>(value);
+            });
+            if (!numeric) {
+                stringCache = std::make_shared<const StringColumn>(toStringColumn(values()));
+            }
+        }
+        return stringCache.get();
+    }
+
+    /**
+     * @brief Returns the per-chunk statistics of the values, built on first use.
+     */
+    std::shared_ptr<const ZoneMap> zoneMap() const {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (!zoneCache) {
+            CDF_TRACE_PHASE(span, "Series::materialize_zone_map");
+            span.rowsIn(values().size());
+            zoneCache = std::make_shared<ZoneMap>(values());
+        }
+        return zoneCache;
+    }
+
+    /**
+     * @brief Builds an index of the given kind over the values, unless there is one already.
+     *
+     * Indexes are shared by every owner of the buffer, modifying the values drops them.
+     *
+     * @throws std::invalid_argument if the values mix strings and numbers
+     */
+    void buildIndex(IndexKind kind) const {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        std::shared_ptr<const ColumnIndex>& slot = indexSlot(kind);
+        if (!slot) {
+            CDF_TRACE_PHASE(span, kind == IndexKind::Hash ? "Index::build_hash" : "Index::build_sorted");
+            span.rowsIn(values().size());
+            slot = std::make_shared<const ColumnIndex>(values(), kind);
+        }
+    }
+
+    /**
+     * @brief Drops the index of the given kind.
+     */
+    void dropIndex(IndexKind kind) const {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        indexSlot(kind).reset();
+    }
+
+    /**
+     * @brief Returns whether an index of the given kind was built.
+     */
+    bool hasIndex(IndexKind kind) const {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        return indexSlot(kind) != nullptr;
+    }
+
+    /**
+     * @brief Answers a comparison with the indexes of the buffer, the hash index first for equality.
+     *
+     * @param rows Receives the matching rows in ascending order.
+     * @return false if no index can answer the comparison, the values have to be scanned.
+     */
+    template <typename Comparator>
+    bool lookupIndexed(const _cdfVal& probe, const Comparator& op, std::vector<int>& rows) const {
+        std::shared_ptr<const ColumnIndex> hashed, sorted;
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex);
+            hashed = hashIndex;
+            sorted = sortedIndex;
         }
+        return (hashed && hashed->lookup(values(), probe, op, rows)) ||
+               (sorted && sorted->lookup(values(), probe, op, rows));
+    }
+
+    /**
+     * @brief Answers a range [low, high] with the sorted index of the buffer.
+     *
+     * @return false if there is no sorted index able to answer the range.
+     */
+    bool lookupBetween(const _cdfVal& low, const _cdfVal& high, std::vector<int>& rows) const {
+        std::shared_ptr<const ColumnIndex> sorted;
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex);
+            sorted = sortedIndex;
+        }
+        return sorted && sorted->lookupBetween(values(), low, high, rows);
+    }
+};
+
+/**
+ * @brief Compares every value of an encoded column with a value, writing one flag per row, with the semantics of
+ * `compareValue`.
+ *
+ * A run-length column compares each run once. Integer encodings are decoded block by block, blocks in parallel.
+ */
+template <typename V, typename Comparator>
+void compareEncoded(const EncodedColumn& column, const V& val, const Comparator& op, uint8_t* flags) {
+    if (column.encoding() == Encoding::RunLength) {
+        size_t begin = 0;
+        for (size_t r = 0; r < column.runs().size(); r++) {
+            size_t end = column.runEnds()[r];
+            std::fill(flags + begin, flags + end, compareValue(column.runs()[r], val, op));
+            begin = end;
+        }
+        return;
+    }
+    size_t blockRows = EncodedColumn::blockRows;
+    parallel::runTasks((column.size() + blockRows - 1) / blockRows, [&](size_t block) {
+        size_t begin = block * blockRows;
+        size_t end = std::min(column.size(), begin + blockRows);
+        column.forEachInt(begin, end, [&](size_t i, int64_t value) {
+            int number = static_cast<int>(value);
+            if constexpr (std::is_same_v<V, std::string>) {
+                flags[i] = !column.isNull(i) && op(to_string(number), val);
+            } else if constexpr (std::is_same_v<V, int>) {
+                flags[i] = !column.isNull(i) && op(number, val);
+            } else {
+                flags[i] = !column.isNull(i) && op(static_cast<double>(number), val);
+            }
+        });
+    });
+}
+
+/**
+ * @brief Compares every value of a buffer with a value, writing one flag per row.
+ *
+ * Chunks of a chunked buffer are compared in parallel, each as a buffer of its own. Encoded buffers are compared in
+ * their encoded form. Otherwise chunks are compared in parallel: the zone map of the
+ * buffer skips the chunks whose bounds rule out every match and fills the chunks whose bounds guarantee one, only
+ * the other chunks are compared value by value.
+ */
+template <typename V, typename Comparator>
+void compareColumn(const ColumnBuffer& buffer, const V& val, const Comparator& op, uint8_t* flags) {
+    if (buffer.chunked()) {
+        std::vector<size_t> offsets = {0};
+        for (auto& chunk : buffer.chunks()) {
+            offsets.push_back(offsets.back() + chunk->size());
+        }
+        parallel::runTasks(buffer.chunks().size(), [&](size_t c) {
+            compareColumn(*buffer.chunks()[c], val, op, flags + offsets[c]);
+        });
+        return;
+    }
+    if (const EncodedColumn* encoded = buffer.encodedColumn()) {
+        compareEncoded(*encoded, val, op, flags);
+        return;
+    }
+    const std::vector<_cdfVal>& values = buffer.values();
+    std::shared_ptr<const ZoneMap> zones = buffer.zoneMap();
+    const StringColumn* strings = nullptr;
+    if constexpr (std::is_same_v<V, std::string>) {
+        strings = buffer.strings();
+    }
+    size_t chunkRows = zones->chunkRows();
+    parallel::runTasks(zones->numChunks(), [&](size_t chunk) {
+        size_t begin = chunk * chunkRows;
+        size_t end = std::min(values.size(), begin + chunkRows);
+        ChunkMatch match = zones->match(chunk, val, op);
+        if (match != ChunkMatch::Some) {
+            std::fill(flags + begin, flags + end, match == ChunkMatch::All);
+            return;
+        }
+        if constexpr (std::is_same_v<V, std::string>) {
+            if (strings) {
+                compareStrings(*strings, val, op, flags, begin, end);
+                return;
+            }
+        }
+        for (size_t i = begin; i < end; i++) {
+            flags[i] = compareValue(values[i], val, op);
+        }
+    });
+}
+
+/**
+ * @class Series
+ * @brief A class that represents a series of heterogeneous data values and provides comparison utilities.
+ *
+ * The Series class stores a sequence of values of type `_cdfVal` (which can hold multiple types, such as int, double,
+ * or std::string) and allows comparisons between the series elements and a provided value using standard comparison
+ * operators (e.g., ==, <, <=, >, >=, !=).
+ */
+class Series {
+    std::shared_ptr<const ColumnBuffer> buffer; /**< Values, possibly shared with a DataFrame column */
+
+    /**
+     * @brief Returns the values as a typed buffer, materialized once per column buffer and reused by every reduction.
+     *
+     * @throws std::runtime_error if string type field is found
+     */
+    const kernels::TypedColumn& typed() const { return buffer->typed(); }
+
+    /**
+     * @brief Compares each string representation of elements in the series with a given string using a custom
+     * comparator.
+     *
+     * @tparam Comparator The type of the comparator function.
+     * @param val The string value to compare against.
+     * @param op The comparator function to use for the comparison.
+     * @return A vector of boolean values indicating the result of the comparison for each element in the series.
+     */
+    template <typename Comparator>
+    std::vector<bool> compareString(const std::string& val, const Comparator& op) const {
+        return compareAll(val, op);
+    }
+
+    /**
+     * @brief Compares each integer element in the series with a given integer using a custom comparator.
+     *
+     * @tparam Comparator The type of the comparator function.
+     * @param val The integer value to compare against.
+     * @param op The comparator function to use for the comparison.
+     * @return A vector of boolean values indicating the result of the comparison for each element in the series.
+     */
+    template <typename Comparator>
+    std::vector<bool> compareInt(int val, const Comparator& op) const {
+        return compareAll(val, op);
+    }
+
+    /**
+     * @brief Compares each double element in the series with a given double using a custom comparator.
+     *
+     * @tparam Comparator The type of the comparator function.
+     * @param val The double value to compare against.
+     * @param op The comparator function to use for the comparison.
+     * @return A vector of boolean values indicating the result of the comparison for each element in the series.
+     */
+    template <typename Comparator>
+    std::vector<bool> compareDouble(double val, const Comparator& op) const {
+        return compareAll(val, op);
+    }
+
+    /**
+     * @brief Compares every element with a value, morsels of elements are compared in parallel.
+     *
+     * @return A vector of boolean values indicating the result of the comparison for each element in the series.
+     */
+    template <typename V, typename Comparator>
+    std::vector<bool> compareAll(const V& val, const Comparator& op) const {
+        // std::vector<bool> packs bits, so the threads write bytes which are packed afterwards
+        size_t n = buffer->size();
+        CDF_TRACE_SPAN(span, "Series::compare");
+        span.rowsIn(n);
+        span.rowsOut(n);
+
+        // An index of the column answers with the matching rows, only the result is written
+        std::vector<int> matches;
+        if (buffer->lookupIndexed(_cdfVal(val), op, matches)) {
+            std::vector<bool> truth(n, false);
+            for (int row : matches) {
+                truth[row] = true;
+            }
+            return truth;
+        }
+
+        ScratchVector<uint8_t> flags(n, scratchResource());
+        compareColumn(*buffer, val, op, flags.data());
+        return std::vector<bool>(flags.begin(), flags.end());
+    }
+
+    /**
+     * @brief Compares elements in the series with a given value using a custom comparator.
+     *
+     * This method routes to the appropriate compare function (compareString, compareInt, or compareDouble) based on
+     * the type of the provided value.
+     *
+     * @tparam T The type of the value to compare.
+     * @tparam Comparator The type of the comparator function.
+     * @param value The value to compare against.
+     * @param op The comparator function to use for the comparison.
+     * @return A vector of boolean values indicating the result of the comparison for each element in the series.
+     */
+    template <typename T, typename Comparator>
+    std::vector<bool> compare(const T& value, const Comparator& op) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            return compareString(value, op);
+        } else if constexpr (std::is_same_v<T, int>) {
+            return compareInt(value, op);
+        } else if constexpr (std::is_same_v<T, double>) {
+            return compareDouble(value, op);
+        } else {
+            std::cout << "Unknown data-type found\n";
+            std::vector<bool> truth(size(), false);
+            return truth;
+        }
+    }
+
+   public:
+    /**
+     * @brief Constructs a Series object from a vector of data values.
+     *
+     * @param series A vector of data values to populate the series with.
+     */
+    Series(std::vector<_cdfVal> series) : buffer(ColumnBuffer::create(std::move(series))) {};
+
+    /**
+     * @brief Constructs a Series sharing an existing buffer of values, nothing is copied.
+     *
+     * @param buffer The values of the series.
+     */
+    explicit Series(std::shared_ptr<const ColumnBuffer> buffer) : buffer(std::move(buffer)) {}
+
+    /**
+     * @brief Returns the shared buffer holding the values of the series.
+     */
+    const std::shared_ptr<const ColumnBuffer>& values() const { return buffer; }
+
+    /**
+     * @brief Returns the size of the series.
+     *
+     * @return The number of values in the series, including nan-values.
+     */
+    size_t size() const { return buffer->size(); }
+
+    /**
+     * @brief Returns the bytes held by the buffer of the series, see `ColumnBuffer::memoryBytes`.
+     *
+     * @param deep Also counts the heap blocks of long strings and the cached typed representations (default is true).
+     */
+    size_t memory_usage(bool deep = true) const { return buffer->memoryBytes(deep); }
+
+    /**
+     * @brief Accesses the value at the specified index in the series.
+     *
+     * @param index The index of the value to access.
+     * @return A constant reference to the value at the given index.
+     * @throws std::out_of_range if the index is out of bounds.
+     */
+    const _cdfVal& operator[](size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("Index out of range!");
+        }
+        return buffer->at(index);
+    }
+
+    /**
+     * @brief Iterators over the values of the series, a chunked series gathers its chunks first (see
+     * `ColumnBuffer::values`).
+     */
+    std::vector<_cdfVal>::const_iterator begin() const { return buffer->values().begin(); }
+    std::vector<_cdfVal>::const_iterator end() const { return buffer->values().end(); }
+
+    /**
+     * @brief Equality comparison operator.
+     *
+     * Compares each element in the series with a provided value for equality.
+     *
+     * @tparam T The type of the value to compare.
+     * @param value The value to compare against.
+     * @return A vector of boolean values indicating equality for each element in the series.
+     */
+    template <typename T>
+    std::vector<bool> operator==(const T& value) {
+        return compare(value, std::equal_to<>{});
+    }
+
+    /**
+     * @brief Not-equal-to comparison operator.
+     *
+     * Compares each element in the series with a provided value for inequality.
+     *
+     * @tparam T The type of the value to compare.
+     * @param value The value to compare against.
+     * @return A vector of boolean values indicating inequality for each element in the series.
+     */
+    template <typename T>
+    std::vector<bool> operator!=(const T& value) {
+        return compare(value, std::not_equal_to<>{});
+    }
+
+    /**
+     * @brief Less-than comparison operator.
+     *
+     * Compares each element in the series with a provided value for "less than".
+     *
+     * @tparam T The type of the value to compare.
+     * @param value The value to compare against.
+     * @return A vector of boolean values indicating the result of "less than" for each element in the series.
+     */
+    template <typename T>
+    std::vector<bool> operator<(const T& value) {
+        return compare(value, std::less<>{});
+    }
+
+    /**
+     * @brief Less-than-or-equal-to comparison operator.
+     *
+     * Compares each element in the series with a provided value for "less than or equal to".
+     *
+     * @tparam T The type of the value to compare.
+     * @param value The value to compare against.
+     * @return A vector of boolean values indicating the result of "less than or equal to" for each element in the
+     * series.
+     */
+    template <typename T>
+    std::vector<bool> operator<=(const T& value) {
+        return compare(value, std::less_equal<>{});
+    }
+
+    /**
+     * @brief Greater-than comparison operator.
+     *
+     * Compares each element in the series with a provided value for "greater than".
+     *
+     * @tparam T The type of the value to compare.
+     * @param value The value to compare against.
+     * @return A vector of boolean values indicating the result of "greater than" for each element in the series.
+     */
+    template <typename T>
+    std::vector<bool> operator>(const T& value) {
+        return compare(value, std::greater<>{});
+    }
+
+    /**
+     * @brief Greater-than-or-equal-to comparison operator.
+     *
+     * Compares each element in the series with a provided value for "greater than or equal to".
+     *
+     * @tparam T The type of the value to compare.
+     * @param value The value to compare against.
+     * @return A vector of boolean values indicating the result of "greater than or equal to" for each element in the
+     * series.
+     */
+    template <typename T>
+    std::vector<bool> operator>=(const T& value) {
+        return compare(value, std::greater_equal<>{});
+    }
+
+    /**
+     * @brief Filteres a set of values
+     *
+     * isin function helps to filter a set of values from series object
+     * @param values A vector of values, for which the presence will be checked
+     *
+     * @returns A vector of boolean where each element comprises the presence of the objects shared above for each index
+     */
+    template <typename T>
+    std::vector<bool> isin(const std::vector<T>& values) {
+        CDF_TRACE_SPAN(span, "Series::isin");
+        span.rowsIn(size());
+        span.rowsOut(size());
+        // Storing each value to string for faster operation
+        std::map<std::string, int> valPresent;
+        for (auto& el : values) {
+            valPresent[to_string(el)]++;
+        }
+
+        std::vector<bool> truth;
+
+        // Updating the values from series object to String format and checking their presence
+        buffer->forEachValue(0, size(), [&](size_t, const _cdfVal& rowVal) {
+            if (valPresent[toString(rowVal)]) {
+                truth.push_back(true);
+            } else {
+                truth.push_back(false);
+            }
+        });
+
+        return truth;
+    }
+
+    /**
+     * @brief Sum Calculator
+     *
+     * Calculates sum of non-string columns, ignores nan-values. Integer columns are accumulated in 64 bits, double
+     * columns with pairwise summation within each morsel. Encoded integer columns are summed in their encoded form.
+     *
+     * @throws std::runtime_error if string type field is found
+     */
+    double sum() const {
+        CDF_TRACE_SPAN(span, "Series::sum");
+        span.rowsIn(size());
+        double total;
+        if (buffer->encodedColumn() && buffer->encodedColumn()->sum(total)) {
+            return total;
+        }
+        const kernels::TypedColumn& column = typed();
+        if (column.isInt) {
+            const int64_t* values = column.ints.data();
+            auto sumRange = [values](size_t begin, size_t end) { return kernels::sum(values + begin, end - begin); };
+            return static_cast<double>(parallel::reduceMorsels<int64_t>(column.size(), 0, sumRange, std::plus<>{}));
+        }
+        const double* values = column.doubles.data();
+        auto sumRange = [values](size_t begin, size_t end) { return kernels::sum(values + begin, end - begin); };
+        return parallel::reduceMorsels<double>(column.size(), 0.0, sumRange, std::plus<>{});
+    }
+
+    /**
+     * @brief Count Calculator
+     *
+     * @returns Number of non-nan values
+     * @throws std::runtime_error if string type field is found
+     */
+    size_t count() const {
+        if (const EncodedColumn* encoded = buffer->encodedColumn()) {
+            return encoded->count();
+        }
+        const kernels::TypedColumn& column = typed();
+        return column.size() - column.nullCount;
+    }
+
+    /**
+     * @brief Mean Calculator
+     *
+     * Calculates mean of non-string columns, ignores nan-values
+     *
+     * @returns Mean of the non-nan values, NaN if there is none
+     * @throws std::runtime_error if string type field is found
+     */
+    double mean() const {
+        CDF_TRACE_SPAN(span, "Series::mean");
+        span.rowsIn(size());
+        size_t n = count();
+        if (n == 0) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        return this->sum() / n;
+    }
+
+    /**
+     * @brief Minimum Calculator
+     *
+     * @returns Minimum of the non-nan values, NaN if there is none
+     * @throws std::runtime_error if string type field is found
+     */
+    double min() const { return extreme<false>(); }
+
+    /**
+     * @brief Maximum Calculator
+     *
+     * @returns Maximum of the non-nan values, NaN if there is none
+     * @throws std::runtime_error if string type field is found
+     */
+    double max() const { return extreme<true>(); }
+
+    /**
+     * @brief Index of the minimum value
+     *
+     * @returns Index of the first occurrence of the minimum, -1 if there is no non-nan value
+     * @throws std::runtime_error if string type field is found
+     */
+    long long argmin() const {
+        const kernels::TypedColumn& column = typed();
+        if (column.isInt) {
+            return kernels::argmin(column.ints.data(), column.validity.data(), column.size());
+        }
+        return kernels::argmin(column.doubles.data(), column.validity.data(), column.size());
+    }
+
+    /**
+     * @brief Index of the maximum value
+     *
+     * @returns Index of the first occurrence of the maximum, -1 if there is no non-nan value
+     * @throws std::runtime_error if string type field is found
+     */
+    long long argmax() const {
+        const kernels::TypedColumn& column = typed();
+        if (column.isInt) {
+            return kernels::argmax(column.ints.data(), column.validity.data(), column.size());
+        }
+        return kernels::argmax(column.doubles.data(), column.validity.data(), column.size());
+    }
+
+    /**
+     * @brief Variance Calculator
+     *
+     * Calculates variance of non-string columns with the two-pass algorithm, ignores nan-values
+     *
+     * @param ddof Delta degrees of freedom, the divisor is `count - ddof` (default is 1, the sample variance)
+     * @returns Variance of the non-nan values, NaN if there are not enough values
+     * @throws std::runtime_error if string type field is found
+     */
+    double var(int ddof = 1) const {
+        CDF_TRACE_SPAN(span, "Series::var");
+        span.rowsIn(size());
+        size_t n = count();
+        if (n <= static_cast<size_t>(std::max(ddof, 0))) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        const kernels::TypedColumn& column = typed();
+        double meanValue = mean();
+        double squares = parallel::reduceMorsels<double>(
+            column.size(), 0.0,
+            [&](size_t begin, size_t end) {
+                const uint8_t* validity = column.validity.data() + begin;
+                return column.isInt ? kernels::sumSquaredDeviations(column.ints.data() + begin, validity, end - begin,
+                                                                    meanValue)
+                                    : kernels::sumSquaredDeviations(column.doubles.data() + begin, validity,
+                                                                    end - begin, meanValue);
+            },
+            std::plus<>{});
+        return squares / (n - ddof);
+    }
+
+    /**
+     * @brief Standard Deviation Calculator
+     *
+     * @param ddof Delta degrees of freedom (default is 1, the sample standard deviation)
+     * @returns Standard deviation of the non-nan values, NaN if there are not enough values
+     * @throws std::runtime_error if string type field is found
+     */
+    double std(int ddof = 1) const { return std::sqrt(var(ddof)); }
+
+    /**
+     * @brief Median Calculator
+     *
+     * Calculates median of non-string columns, ignores nan-values
+     *
+     * @returns Median of the non-nan values, NaN if there is none
+     * @throws std::runtime_error if string type field is found
+     */
+    double median() const {
+        CDF_TRACE_SPAN(span, "Series::median");
+        span.rowsIn(size());
+        const kernels::TypedColumn& column = typed();
+        std::vector<double> values;
+        values.reserve(count());
+        for (size_t i = 0; i < column.size(); i++) {
+            if (column.validity[i]) {
+                values.push_back(column.isInt ? static_cast<double>(column.ints[i]) : column.doubles[i]);
+            }
+        }
+        if (values.empty()) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        int medIdx = values.size() / 2;
+        std::nth_element(values.begin(), values.begin() + medIdx, values.end());
+        return values[medIdx];
+    }
+
+    /**
+     * @brief Mode Calculator for Columns with String Data-Type
+     *
+     * Calculates mode of the column values, ignores nan-values and NaN doubles. Among equally frequent values, the one
+     * reaching the highest count first wins.
+     * @returns mode value in string format, empty if there is no non-nan value
+     */
+    std::string mode() const {
+        CDF_TRACE_SPAN(span, "Series::mode");
+        span.rowsIn(size());
+        long long modeIdx = -1;
+        countDistinct(&modeIdx);
+        return modeIdx < 0 ? std::string("") : toString(buffer->at(modeIdx));
+    }
+
+    /**
+     * @brief Mode Calculator for Columns with Non-String Data-Type
+     *
+     * Calculates mode of the column values, ignores nan-values and NaN doubles
+     * @returns mode value in non-string format
+     * @throws std::runtime_error if there is no non-nan value or the mode is a string
+     */
+    template <typename T, typename = std::enable_if_t<std::is_same_v<T, int> || std::is_same_v<T, double>>>
+    T mode() const {
+        CDF_TRACE_SPAN(span, "Series::mode");
+        span.rowsIn(size());
+        long long modeIdx = -1;
+        countDistinct(&modeIdx);
+        if (modeIdx < 0) {
+            throw std::runtime_error("[cdf][Series] Mode of an empty series is undefined!");
+        }
+
+        const _cdfVal& modeVal = buffer->at(modeIdx);
+        if (std::holds_alternative<int>(modeVal)) {
+            return static_cast<T>(std::get<int>(modeVal));
+        } else if (std::holds_alternative<double>(modeVal)) {
+            return static_cast<T>(std::get<double>(modeVal));
+        }
+        throw std::runtime_error("String Data-Type isn't expected!");
+    }
+
+    /**
+     * @brief Counts the occurrences of every distinct value
+     *
+     * @param sort Orders the values by descending count when true, by first occurrence otherwise (default is true)
+     * @param topK Keeps only the topK most frequent values, 0 keeps all of them (default is 0)
+     * @returns DataFrame with a `value` and a `count` column, nan-values and NaN doubles are ignored
+     */
+    DataFrame value_counts(bool sort = true, size_t topK = 0) const;
+
+    /**
+     * @brief Distinct values of the series
+     *
+     * @returns Series of the distinct non-nan values in order of first occurrence, NaN doubles are left out too
+     */
+    Series unique() const {
+        std::vector<_cdfVal> values;
+        for (auto& [firstIdx, count] : countDistinct()) {
+            values.push_back(buffer->at(firstIdx));
+        }
+        return Series(values);
+    }
+
+    /**
+     * @brief Number of distinct values of the series
+     *
+     * @returns Number of distinct non-nan values, NaN doubles are not counted either
+     */
+    size_t nunique() const { return countDistinct().size(); }
+
+    /**
+     * @brief Element-wise addition of two series
+     *
+     * Arithmetic runs over typed buffers: integer series give integer series, anything involving a double (and every
+     * division) gives doubles. A nan-value on either side gives a nan-value, so does a NaN result such as `0.0 / 0.0`.
+     *
+     * @param other A series of the same size
+     * @returns Series of the sums
+     * @throws std::length_error if the sizes of the series differ
+     * @throws std::runtime_error if string type field is found
+     */
+    Series operator+(const Series& other) const { return arithmetic<std::plus<>>(other); }
+
+    /**
+     * @brief Element-wise subtraction of two series, see `operator+`
+     */
+    Series operator-(const Series& other) const { return arithmetic<std::minus<>>(other); }
+
+    /**
+     * @brief Element-wise multiplication of two series, see `operator+`
+     */
+    Series operator*(const Series& other) const { return arithmetic<std::multiplies<>>(other); }
+
+    /**
+     * @brief Element-wise division of two series, always gives doubles, see `operator+`
+     */
+    Series operator/(const Series& other) const { return arithmetic<std::divides<>>(other); }
+
+    /**
+     * @brief Adds a scalar to every value, see `operator+`
+     *
+     * @param value An integer or floating-point scalar
+     */
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    Series operator+(T value) const {
+        return arithmetic<std::plus<>>(value, false);
+    }
+
+    /**
+     * @brief Subtracts a scalar from every value, see `operator+`
+     */
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    Series operator-(T value) const {
+        return arithmetic<std::minus<>>(value, false);
+    }
+
+    /**
+     * @brief Multiplies every value by a scalar, see `operator+`
+     */
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    Series operator*(T value) const {
+        return arithmetic<std::multiplies<>>(value, false);
+    }
+
+    /**
+     * @brief Divides every value by a scalar, see `operator+`
+     */
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    Series operator/(T value) const {
+        return arithmetic<std::divides<>>(value, false);
+    }
+
+    /**
+     * @brief Applies an arithmetic operator between a scalar on the left and every value, see `operator+`
+     */
+    template <typename Op, typename T>
+    Series scalarFirst(T value) const {
+        return arithmetic<Op>(value, true);
+    }
+
+    /**
+     * @brief Absolute values, integer series stay integral
+     *
+     * @throws std::runtime_error if string type field is found
+     */
+    Series abs() const {
+        return fromTyped(kernels::unaryOp(typed(), true, [](auto v) { return v < 0 ? -v : v; }));
+    }
+
+    /**
+     * @brief Natural logarithms, as doubles. Negative values give nan-values.
+     *
+     * @throws std::runtime_error if string type field is found
+     */
+    Series log() const {
+        return fromTyped(kernels::unaryOp(typed(), false, [](double v) { return std::log(v); }));
+    }
+
+    /**
+     * @brief Exponentials, as doubles
+     *
+     * @throws std::runtime_error if string type field is found
+     */
+    Series exp() const {
+        return fromTyped(kernels::unaryOp(typed(), false, [](double v) { return std::exp(v); }));
+    }
+
+    /**
+     * @brief Rounds the values half away from zero, integer series are returned unchanged
+     *
+     * @param decimals Number of decimals to keep (default is 0)
+     * @throws std::runtime_error if string type field is found
+     */
+    Series round(int decimals = 0) const {
+        double scale = std::pow(10.0, decimals);
+        return fromTyped(kernels::unaryOp(typed(), true, [scale](auto v) {
+            if constexpr (std::is_integral_v<decltype(v)>) {
+                return v;
+            } else {
+                return std::round(v * scale) / scale;
+            }
+        }));
+    }
+
+    /**
+     * @class Window
+     * @brief Aggregates over sliding windows of a series, see `Series::rolling` and `Series::expanding`.
+     *
+     * Each aggregate costs O(n) whatever the window size: sums and means keep a running sum, variances a running
+     * Welford state, minima and maxima a deque of candidates. Morsels of rows are computed in parallel. Nan-values
+     * are skipped, windows with fewer values than the minimum give nan-values.
+     */
+    class Window {
+        std::shared_ptr<const ColumnBuffer> buffer;
+        size_t window;
+        size_t minPeriods;
+
+        kernels::TypedColumn aggregate(kernels::WindowAgg agg, int ddof = 1) const {
+            CDF_TRACE_SPAN(span, "Series::rolling");
+            span.rowsIn(buffer->size());
+            span.rowsOut(buffer->size());
+            return kernels::rollingAggregate(buffer->typed(), window, minPeriods, agg, ddof);
+        }
+
+       public:
+        Window(std::shared_ptr<const ColumnBuffer> buffer, size_t window, size_t minPeriods)
+            : buffer(std::move(buffer)), window(window), minPeriods(minPeriods) {}
+
+        /**
+         * @brief Number of non-nan values in each window
+         */
+        Series count() const { return fromTyped(aggregate(kernels::WindowAgg::Count)); }
+
+        /**
+         * @brief Sum of each window, integer series stay integral
+         *
+         * @throws std::runtime_error if string type field is found
+         */
+        Series sum() const { return fromTyped(aggregate(kernels::WindowAgg::Sum)); }
+
+        /**
+         * @brief Mean of each window
+         *
+         * @throws std::runtime_error if string type field is found
+         */
+        Series mean() const { return fromTyped(aggregate(kernels::WindowAgg::Mean)); }
+
+        /**
+         * @brief Minimum of each window
+         *
+         * @throws std::runtime_error if string type field is found
+         */
+        Series min() const { return fromTyped(aggregate(kernels::WindowAgg::Min)); }
+
+        /**
+         * @brief Maximum of each window
+         *
+         * @throws std::runtime_error if string type field is found
+         */
+        Series max() const { return fromTyped(aggregate(kernels::WindowAgg::Max)); }
+
+        /**
+         * @brief Variance of each window
+         *
+         * @param ddof Delta degrees of freedom (default is 1, the sample variance)
+         * @throws std::runtime_error if string type field is found
+         */
+        Series var(int ddof = 1) const { return fromTyped(aggregate(kernels::WindowAgg::Var, ddof)); }
+
+        /**
+         * @brief Standard deviation of each window
+         *
+         * @param ddof Delta degrees of freedom (default is 1, the sample standard deviation)
+         * @throws std::runtime_error if string type field is found
+         */
+        Series std(int ddof = 1) const {
+            kernels::TypedColumn variance = aggregate(kernels::WindowAgg::Var, ddof);
+            return fromTyped(kernels::unaryOp(variance, false, [](double v) { return std::sqrt(v); }));
+        }
+    };
+
+    /**
+     * @brief Windows of a fixed number of rows ending at every row.
+     *
+     * Example:
+     * ```
+     * auto smoothed = df["latency"].rolling(300).mean();
+     * ```
+     *
+     * @param window The number of rows of each window.
+     * @param minPeriods The minimum number of non-nan values of a window (default is 0, the window size).
+     * @throws std::invalid_argument if the window is empty
+     */
+    Window rolling(size_t window, size_t minPeriods = 0) const {
+        if (window == 0) {
+            throw std::invalid_argument("[cdf][Series] Window size must be positive");
+        }
+        return Window(buffer, window, minPeriods == 0 ? window : minPeriods);
+    }
+
+    /**
+     * @brief Windows from the first row to every row.
+     *
+     * @param minPeriods The minimum number of non-nan values of a window (default is 1).
+     */
+    Window expanding(size_t minPeriods = 1) const {
+        return Window(buffer, std::max<size_t>(size(), 1), std::max<size_t>(minPeriods, 1));
     }
 
-   public:
     /**
-     * @brief Constructs a Series object from a vector of data values.
+     * @brief Cumulative sum, nan-values are skipped and stay nan-values. Integer series stay integral.
      *
-     * @param series A vector of data values to populate the series with.
+     * @throws std::runtime_error if string type field is found
      */
-    Series(std::vector<_cdfVal> series) : series(series) {};
+    Series cumsum() const {
+        CDF_TRACE_SPAN(span, "Series::cumsum");
+        span.rowsIn(size());
+        return fromTyped(kernels::cumulative(typed(), true, [](auto a, auto b) { return a + b; }));
+    }
 
     /**
-     * @brief Equality comparison operator.
+     * @brief Cumulative product, as doubles. Nan-values are skipped and stay nan-values.
      *
-     * Compares each element in the series with a provided value for equality.
-     *
-     * @tparam T The type of the value to compare.
-     * @param value The value to compare against.
-     * @return A vector of boolean values indicating equality for each element in the series.
+     * @throws std::runtime_error if string type field is found
      */
-    template <typename T>
-    std::vector<bool> operator==(const T& value) {
-        return compare(value, std::equal_to<>{});
+    Series cumprod() const {
+        CDF_TRACE_SPAN(span, "Series::cumprod");
+        span.rowsIn(size());
+        return fromTyped(kernels::cumulative(typed(), false, [](auto a, auto b) { return a * b; }));
     }
 
     /**
-     * @brief Not-equal-to comparison operator.
-     *
-     * Compares each element in the series with a provided value for inequality.
+     * @brief Cumulative maximum, nan-values are skipped and stay nan-values. Integer series stay integral.
      *
-     * @tparam T The type of the value to compare.
-     * @param value The value to compare against.
-     * @return A vector of boolean values indicating inequality for each element in the series.
+     * @throws std::runtime_error if string type field is found
      */
-    template <typename T>
-    std::vector<bool> operator!=(const T& value) {
-        return compare(value, std::not_equal_to<>{});
+    Series cummax() const {
+        CDF_TRACE_SPAN(span, "Series::cummax");
+        span.rowsIn(size());
+        return fromTyped(kernels::cumulative(typed(), true, [](auto a, auto b) { return std::max(a, b); }));
     }
 
     /**
-     * @brief Less-than comparison operator.
+     * @brief Cumulative minimum, nan-values are skipped and stay nan-values. Integer series stay integral.
      *
-     * Compares each element in the series with a provided value for "less than".
-     *
-     * @tparam T The type of the value to compare.
-     * @param value The value to compare against.
-     * @return A vector of boolean values indicating the result of "less than" for each element in the series.
+     * @throws std::runtime_error if string type field is found
      */
-    template <typename T>
-    std::vector<bool> operator<(const T& value) {
-        return compare(value, std::less<>{});
+    Series cummin() const {
+        CDF_TRACE_SPAN(span, "Series::cummin");
+        span.rowsIn(size());
+        return fromTyped(kernels::cumulative(typed(), true, [](auto a, auto b) { return std::min(a, b); }));
     }
 
     /**
-     * @brief Less-than-or-equal-to comparison operator.
-     *
-     * Compares each element in the series with a provided value for "less than or equal to".
+     * @brief Shifts the values by a number of rows, vacated rows hold nan-values. Works for every type.
      *
-     * @tparam T The type of the value to compare.
-     * @param value The value to compare against.
-     * @return A vector of boolean values indicating the result of "less than or equal to" for each element in the
-     * series.
+     * @param periods Rows to shift by, negative values shift towards the first row (default is 1).
      */
-    template <typename T>
-    std::vector<bool> operator<=(const T& value) {
-        return compare(value, std::less_equal<>{});
+    Series shift(long long periods = 1) const {
+        CDF_TRACE_SPAN(span, "Series::shift");
+        span.rowsIn(size());
+        long long n = static_cast<long long>(size());
+        std::vector<_cdfVal> shifted(size(), NaN());
+        long long begin = std::max(0LL, periods), end = std::min(n, n + periods);
+        if (begin < end) {
+            buffer->forEachValue(begin - periods, end - periods,
+                                 [&](size_t i, const _cdfVal& value) { shifted[i + periods] = value; });
+        }
+        return Series(std::move(shifted));
     }
 
     /**
-     * @brief Greater-than comparison operator.
-     *
-     * Compares each element in the series with a provided value for "greater than".
+     * @brief Difference with the value `periods` rows before, integer series stay integral.
      *
-     * @tparam T The type of the value to compare.
-     * @param value The value to compare against.
-     * @return A vector of boolean values indicating the result of "greater than" for each element in the series.
+     * @param periods Rows between the values (default is 1), negative values compare with following rows.
+     * @throws std::runtime_error if string type field is found
      */
-    template <typename T>
-    std::vector<bool> operator>(const T& value) {
-        return compare(value, std::greater<>{});
+    Series diff(long long periods = 1) const {
+        CDF_TRACE_SPAN(span, "Series::diff");
+        span.rowsIn(size());
+        return fromTyped(kernels::lagOp(typed(), periods, true, [](auto a, auto b) { return a - b; }));
     }
 
     /**
-     * @brief Greater-than-or-equal-to comparison operator.
-     *
-     * Compares each element in the series with a provided value for "greater than or equal to".
+     * @brief Relative change from the value `periods` rows before, as doubles. A change from 0 is infinite.
      *
-     * @tparam T The type of the value to compare.
-     * @param value The value to compare against.
-     * @return A vector of boolean values indicating the result of "greater than or equal to" for each element in the
-     * series.
+     * @param periods Rows between the values (default is 1), negative values compare with following rows.
+     * @throws std::runtime_error if string type field is found
      */
-    template <typename T>
-    std::vector<bool> operator>=(const T& value) {
-        return compare(value, std::greater_equal<>{});
+    Series pct_change(long long periods = 1) const {
+        CDF_TRACE_SPAN(span, "Series::pct_change");
+        span.rowsIn(size());
+        return fromTyped(kernels::lagOp(typed(), periods, false, [](auto a, auto b) { return a / b - 1; }));
     }
 
+   private:
     /**
-     * @brief Filteres a set of values
-     *
-     * isin function helps to filter a set of values from series object
-     * @param values A vector of values, for which the presence will be checked
-     *
-     * @returns A vector of boolean where each element comprises the presence of the objects shared above for each index
+     * @brief Minimum (or maximum) of the non-nan values, computed morsel by morsel
      */
-    template <typename T>
-    std::vector<bool> isin(const std::vector<T>& values) {
-        // Storing each value to string for faster operation
-        std::map<std::string, int> valPresent;
-        for (auto& el : values) {
-            valPresent[to_string(el)]++;
+    template <bool Greater>
+    double extreme() const {
+        CDF_TRACE_SPAN(span, Greater ? "Series::max" : "Series::min");
+        span.rowsIn(size());
+        const kernels::TypedColumn& column = typed();
+        if (count() == 0) {
+            return std::numeric_limits<double>::quiet_NaN();
         }
-
-        std::vector<bool> truth;
-
-        // Updating the values from series object to String format and checking their presence
-        for (auto& rowVal : series) {
-            if (valPresent[toString(rowVal)]) {
-                truth.push_back(true);
-            } else {
-                truth.push_back(false);
-            }
+        auto pick = [](auto a, auto b) { return Greater ? std::max(a, b) : std::min(a, b); };
+        const uint8_t* validity = column.validity.data();
+        if (column.isInt) {
+            const int64_t* values = column.ints.data();
+            int64_t neutral = Greater ? std::numeric_limits<int64_t>::lowest() : std::numeric_limits<int64_t>::max();
+            return static_cast<double>(parallel::reduceMorsels<int64_t>(
+                column.size(), neutral,
+                [&](size_t begin, size_t end) {
+                    return kernels::extreme<Greater>(values + begin, validity + begin, end - begin);
+                },
+                pick));
         }
-
-        return truth;
+        const double* values = column.doubles.data();
+        double neutral = Greater ? std::numeric_limits<double>::lowest() : std::numeric_limits<double>::max();
+        return parallel::reduceMorsels<double>(
+            column.size(), neutral,
+            [&](size_t begin, size_t end) {
+                return kernels::extreme<Greater>(values + begin, validity + begin, end - begin);
+            },
+            pick);
     }
 
     /**
-     * @brief Sum Calculator
-     *
-     * Calculates sum of non-string columns, ignores nan-values
-     *
-     * @throws std::runtime_error if string type field is found
+     * @brief Builds a series from a computed typed buffer, which is kept as the typed cache of the result
      */
-    double sum() const {
-        double sumValue = 0;
+    static Series fromTyped(kernels::TypedColumn column) {
+        auto buffer = ColumnBuffer::create(kernels::toValues(column));
+        buffer->setTyped(std::move(column));
+        return Series(std::shared_ptr<const ColumnBuffer>(std::move(buffer)));
+    }
 
-        for (auto& rowVal : series) {
-            if (std::holds_alternative<cdf::NaN>(rowVal)) {
-                continue;
-            } else if (std::holds_alternative<int>(rowVal)) {
-                sumValue += static_cast<double>(std::get<int>(rowVal));
-            } else if (std::holds_alternative<double>(rowVal)) {
-                sumValue += std::get<double>(rowVal);
-            } else {
-                throw std::runtime_error("String Data-Type isn't expected!");
-            }
+    /**
+     * @brief Element-wise arithmetic between two series
+     */
+    template <typename Op>
+    Series arithmetic(const Series& other) const {
+        if (size() != other.size()) {
+            throw std::length_error("[cdf][Series] Series sizes don't match");
         }
-
-        return sumValue;
+        CDF_TRACE_SPAN(span, "Series::arithmetic");
+        span.rowsIn(size());
+        span.rowsOut(size());
+        return fromTyped(kernels::binaryOp<Op>(typed(), other.typed()));
     }
 
     /**
-     * @brief Mean Calculator
-     *
-     * Calculates mean of non-string columns, ignores nan-values
-     *
-     * @throws std::runtime_error if string type field is found
+     * @brief Element-wise arithmetic between the series and a scalar
      */
-    double mean() { return this->sum() / series.size(); }
+    template <typename Op, typename T>
+    Series arithmetic(T value, bool valueFirst) const {
+        CDF_TRACE_SPAN(span, "Series::arithmetic");
+        span.rowsIn(size());
+        span.rowsOut(size());
+        if constexpr (std::is_integral_v<T>) {
+            return fromTyped(kernels::scalarOp<Op>(typed(), static_cast<int64_t>(value), valueFirst));
+        } else {
+            return fromTyped(kernels::scalarOp<Op>(typed(), static_cast<double>(value), valueFirst));
+        }
+    }
 
     /**
-     * @brief Median Calculator
+     * @brief Counts the distinct non-nan values with an open-addressing hash table, NaN doubles count as nan-values
      *
-     * Calculates median of non-string columns, ignores nan-values
+     * Integer and double columns are keyed on their typed values, string columns on views of the stored strings, so
+     * no value is converted or copied. Columns mixing strings and numbers fall back to comparing the variants.
      *
-     * @throws std::runtime_error if string type field is found
+     * @param modeIdx If given, receives the index of the first value reaching the highest count (-1 if none)
+     * @returns Pairs of (index of the first occurrence, count), one per distinct value, in order of first occurrence
      */
-    double median() {
-        std::vector<double> values;
-        for (auto& rowVal : series) {
-            if (std::holds_alternative<cdf::NaN>(rowVal)) {
-                continue;
-            } else if (std::holds_alternative<int>(rowVal)) {
-                values.push_back(static_cast<double>(std::get<int>(rowVal)));
-            } else if (std::holds_alternative<double>(rowVal)) {
-                values.push_back(std::get<double>(rowVal));
-            } else {
-                throw std::runtime_error("String Data-Type isn't expected!");
+    std::vector<std::pair<size_t, uint64_t>> countDistinct(long long* modeIdx = nullptr) const {
+        const ColumnBuffer& series = *buffer;
+        bool hasStrings = false, hasNumbers = false;
+        series.valueKinds(hasStrings, hasNumbers);
+
+        if (!hasStrings) {
+            const kernels::TypedColumn& column = typed();
+            if (column.isInt) {
+                return countBy<int64_t, IntegerHash>([&](size_t i) { return column.ints[i]; },
+                                                     [&](size_t i) { return column.validity[i] != 0; }, modeIdx);
             }
+            return countBy<double, DoubleHash>(
+                [&](size_t i) { return column.doubles[i]; },
+                [&](size_t i) { return column.validity[i] != 0 && !std::isnan(column.doubles[i]); }, modeIdx);
+        } else if (!hasNumbers) {
+            return countBy<std::string_view, StringViewHash>(
+                [&](size_t i) { return std::string_view(std::get<std::string>(series.at(i))); },
+                [&](size_t i) { return std::holds_alternative<std::string>(series.at(i)); }, modeIdx);
         }
-        sort(values.begin(), values.end());
-
-        int medIdx = values.size() / 2;
-        return values[medIdx];
+        return countBy<const _cdfVal*, VariantPtrHash, VariantPtrEqual>(
+            [&](size_t i) { return &series.at(i); },
+            [&](size_t i) { return !isMissing(series.at(i)); }, modeIdx);
     }
 
     /**
-     * @brief Mode Calculator for Columns with String Data-Type
-     *
-     * Calculates mode of the column values, ignores nan-values
-     * @returns mode value in string format
+     * @brief Hash-counting loop shared by every key type of countDistinct
      */
-    std::string mode() {
-        std::map<std::string, int> counter;
-
-        int maxCounter = 0;
-        std::string strVal, modeValString = std::string("");
+    template <typename Key, typename Hash, typename Equal = std::equal_to<Key>, typename KeyOf, typename IsValid>
+    std::vector<std::pair<size_t, uint64_t>> countBy(const KeyOf& keyOf, const IsValid& isValid,
+                                                     long long* modeIdx) const {
+        OpenHashMap<Key, std::pair<size_t, uint64_t>, Hash, Equal> counter;
+        uint64_t maxCounter = 0;
+        if (modeIdx) {
+            *modeIdx = -1;
+        }
 
-        // Iterate through the elements and count the max present element
-        for (auto& rowVal : series) {
-            if (std::holds_alternative<NaN>(rowVal)) {
+        for (size_t i = 0; i < size(); i++) {
+            if (!isValid(i)) {
                 continue;
-            } else {
-                strVal = toString(rowVal);
-
-                // Update frequencies of the elements and update mode
-                counter[strVal]++;
-                if (counter[strVal] > maxCounter) {
-                    modeValString = strVal;
-                    maxCounter = counter[strVal];
+            }
+            auto entry = counter.insert(keyOf(i), std::make_pair(i, 0)).first;
+            std::pair<size_t, uint64_t>& slot = counter.value(entry);
+            if (++slot.second > maxCounter) {
+                maxCounter = slot.second;
+                if (modeIdx) {
+                    *modeIdx = slot.first;
                 }
             }
         }
-        return modeValString;
+        return counter.allValues();
     }
+};
 
-    /**
-     * @brief Mode Calculator for Columns with Non-String Data-Type
-     *
-     * Calculates mode of the column values, ignores nan-values
-     * @returns mode value in non-string format
-     */
-    template <typename T, typename = std::enable_if_t<std::is_same_v<T, int> || std::is_same_v<T, double>>>
-    T mode() {
-        double modeVal = std::stod(mode());
+/**
+ * @brief Adds every value of a series to a scalar, see `Series::operator+`
+ */
+template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+Series operator+(T value, const Series& series) {
+    return series.scalarFirst<std::plus<>>(value);
+}
 
-        return static_cast<T>(modeVal);
-    }
-};
+/**
+ * @brief Subtracts every value of a series from a scalar, see `Series::operator+`
+ */
+template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+Series operator-(T value, const Series& series) {
+    return series.scalarFirst<std::minus<>>(value);
+}
+
+/**
+ * @brief Multiplies a scalar by every value of a series, see `Series::operator+`
+ */
+template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+Series operator*(T value, const Series& series) {
+    return series.scalarFirst<std::multiplies<>>(value);
+}
+
+/**
+ * @brief Divides a scalar by every value of a series, see `Series::operator+`
+ */
+template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+Series operator/(T value, const Series& series) {
+    return series.scalarFirst<std::divides<>>(value);
+}
 
 /**
  * @brief Represents a collection of rows of data, akin to a 2D matrix or dataframe.
  *
- * The Data class stores a collection of Row objects and provides methods to access and manipulate the data,
- * as well as retrieve the shape of the dataset.
+ * The Data class stores the values column by column, every column being one contiguous vector, or a chain of
+ * immutable chunks once rows were appended with `append`. Rows are assembled on access, while scans over a column,
+ * column projections and new columns never touch the other columns.
+ *
+ * Column buffers are reference-counted and shared between Data objects and Series, copying a Data object only copies
+ * the references. A buffer is copied when it is modified while shared (copy-on-write).
  */
 class Data {
-    std::vector<Row> _data;
+    std::vector<std::shared_ptr<const ColumnBuffer>> _columns;
+
+    /**
+     * @brief Returns the buffer of a column for modification, copying it first if it is shared
+     */
+    ColumnBuffer& ownedBuffer(size_t colIdx) { return ColumnBuffer::owned(_columns[colIdx]); }
+
+    /**
+     * @brief Returns a column for modification, copying its buffer first if it is shared
+     */
+    std::vector<_cdfVal>& mutableColumn(size_t colIdx) { return ownedBuffer(colIdx).mutableValues(); }
 
    public:
     int rowN, colN;
@@ -425,6 +1816,9 @@ class Data {
      * @param rowLength The number of columns in each row.
      */
     Data(int rowLength = 0) {
+        for (int j = 0; j < rowLength; j++) {
+            _columns.push_back(ColumnBuffer::create());
+        }
         rowN = 0;
         colN = rowLength;
     }
@@ -434,7 +1828,7 @@ class Data {
      *
      * @return The number of rows in the dataset.
      */
-    size_t size() { return rowN; }
+    size_t size() const { return rowN; }
 
     /**
      * @brief Returns the shape of the dataset as a pair of (rows, columns).
@@ -444,17 +1838,55 @@ class Data {
     std::pair<int, int> shape() { return std::make_pair(rowN, colN); }
 
     /**
-     * @brief Accesses the row at the specified index.
+     * @brief Assembles the row at the specified index.
      *
      * @param index The index of the row to access.
-     * @return A constant reference to the row at the given index.
+     * @return A copy of the values of the row.
+     * @throws std::out_of_range if the index is out of bounds.
+     */
+    Row operator[](size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("Index out of range!");
+        }
+        std::vector<_cdfVal> row;
+        row.reserve(colN);
+        for (auto& column : _columns) {
+            row.push_back(column->at(index));
+        }
+        return Row(row);
+    }
+
+    /**
+     * @brief Accesses a single value without bounds checking.
+     *
+     * @param rowIdx The index of the row.
+     * @param colIdx The index of the column.
+     * @return A constant reference to the value.
+     */
+    const _cdfVal& cell(size_t rowIdx, size_t colIdx) const { return _columns[colIdx]->at(rowIdx); }
+
+    /**
+     * @brief Accesses the values of a column, a chunked column gathers its chunks first (see `ColumnBuffer::values`).
+     *
+     * @param colIdx The index of the column.
+     * @return A constant reference to the values of the column, one per row.
+     * @throws std::out_of_range if the index is out of bounds.
+     */
+    const std::vector<_cdfVal>& column(size_t colIdx) const {
+        return columnBuffer(colIdx)->values();
+    }
+
+    /**
+     * @brief Returns the shared buffer of a column, to share it without copying.
+     *
+     * @param colIdx The index of the column.
      * @throws std::out_of_range if the index is out of bounds.
      */
-    const Row& operator[](size_t index) const {
-        if (index >= _data.size()) {
+    const std::shared_ptr<const ColumnBuffer>& columnBuffer(size_t colIdx) const {
+        if (colIdx >= _columns.size()) {
             throw std::out_of_range("Index out of range!");
         }
-        return _data[index];
+        return _columns[colIdx];
     }
 
     /**
@@ -465,7 +1897,9 @@ class Data {
      */
     void push_back(Row& row) {
         if (row.size() == colN) {
-            _data.push_back(row);
+            for (int j = 0; j < colN; j++) {
+                ownedBuffer(j).append(row[j]);
+            }
             ++rowN;
         } else {
             std::cout << "[Data][push_back] Expected " << colN << " columns, found " << row.size() << "\n";
@@ -483,6 +1917,171 @@ class Data {
         Row _row = Row(row);
         push_back(_row);
     }
+
+    /**
+     * @brief Adds a new row to the dataset, moving its values into the columns.
+     *
+     * @param row (Vector of _cdfVal) The row to add.
+     * @throws std::length_error if the size of the row does not match the number of columns.
+     */
+    void push_back(std::vector<_cdfVal>&& row) {
+        if (row.size() != static_cast<size_t>(colN)) {
+            std::cout << "[Data][push_back] Expected " << colN << " columns, found " << row.size() << "\n";
+            throw std::length_error("Row size not matching with column size");
+        }
+        for (int j = 0; j < colN; j++) {
+            ownedBuffer(j).append(std::move(row[j]));
+        }
+        ++rowN;
+    }
+
+    /**
+     * @brief Adds a new row to the dataset, moving its values into the columns.
+     *
+     * @param row The row to add.
+     * @throws std::length_error if the size of the row does not match the number of columns.
+     */
+    void push_back(Row&& row) { push_back(std::move(row._row)); }
+
+    /**
+     * @brief Adds a new row built in place from one value per column.
+     *
+     * Example:
+     * ```
+     * data.emplace_row(1, "Alice", 25.5, cdf::NaN());
+     * ```
+     *
+     * @param values The values of the row, anything a `_cdfVal` can be constructed from.
+     * @throws std::length_error if the number of values does not match the number of columns.
+     */
+    template <typename... Values>
+    void emplace_row(Values&&... values) {
+        if (sizeof...(Values) != colN) {
+            std::cout << "[Data][emplace_row] Expected " << colN << " columns, found " << sizeof...(Values) << "\n";
+            throw std::length_error("Row size not matching with column size");
+        }
+        int j = 0;
+        (ownedBuffer(j++).append(_cdfVal(std::forward<Values>(values))), ...);
+        ++rowN;
+    }
+
+    /**
+     * @brief Appends rows held by one buffer per column, as chunks: the buffers are shared and the values already
+     * held are never moved, see `ColumnBuffer::appendChunk`.
+     *
+     * @param columns The buffers of the rows to append, one per column and all of the same size.
+     * @throws std::length_error if the number of buffers does not match the number of columns, or their sizes differ.
+     */
+    void append(const std::vector<std::shared_ptr<const ColumnBuffer>>& columns) {
+        if (columns.size() != static_cast<size_t>(colN)) {
+            std::cout << "[Data][append] Expected " << colN << " columns, found " << columns.size() << "\n";
+            throw std::length_error("Row size not matching with column size");
+        }
+        size_t rows = columns.empty() ? 0 : columns[0]->size();
+        for (auto& column : columns) {
+            if (column->size() != rows) {
+                throw std::length_error("Column size not matching with row size");
+            }
+        }
+        for (int j = 0; j < colN; j++) {
+            if (_columns[j].use_count() == 1) {
+                ownedBuffer(j).appendChunk(columns[j]);
+            } else {
+                // A shared buffer stays as it is for its other owners, it becomes the first chunk of a new buffer
+                _columns[j] = ColumnBuffer::create(
+                    std::vector<std::shared_ptr<const ColumnBuffer>>{_columns[j], columns[j]});
+            }
+        }
+        rowN += rows;
+    }
+
+    /**
+     * @brief Makes room for a number of rows in every column, so appending them does not reallocate.
+     *
+     * @param rows The total number of rows to make room for.
+     */
+    void reserve(size_t rows) {
+        for (int j = 0; j < colN; j++) {
+            mutableColumn(j).reserve(rows);
+        }
+    }
+
+    /**
+     * @brief Appends a column after the existing ones.
+     *
+     * The first column added to a dataset without columns sets the number of rows.
+     *
+     * @param values The values of the column, one per row.
+     * @throws std::length_error if the number of values does not match the number of rows.
+     */
+    void addColumn(std::vector<_cdfVal> values) {
+        addColumn(ColumnBuffer::create(std::move(values)));
+    }
+
+    /**
+     * @brief Appends a column sharing an existing buffer, nothing is copied.
+     *
+     * @param buffer The buffer of the column, one value per row.
+     * @throws std::length_error if the number of values does not match the number of rows.
+     */
+    void addColumn(std::shared_ptr<const ColumnBuffer> buffer) {
+        if (colN > 0 && buffer->size() != size()) {
+            throw std::length_error("Column size not matching with row size");
+        }
+        rowN = buffer->size();
+        _columns.push_back(std::move(buffer));
+        ++colN;
+    }
+
+    /**
+     * @brief Replaces the values of an existing column.
+     *
+     * @param colIdx The index of the column.
+     * @param values The new values of the column, one per row.
+     * @throws std::out_of_range if the index is out of bounds.
+     * @throws std::length_error if the number of values does not match the number of rows.
+     */
+    void setColumn(size_t colIdx, std::vector<_cdfVal> values) {
+        setColumn(colIdx, ColumnBuffer::create(std::move(values)));
+    }
+
+    /**
+     * @brief Replaces an existing column by a shared buffer, nothing is copied.
+     *
+     * @param colIdx The index of the column.
+     * @param buffer The buffer of the column, one value per row.
+     * @throws std::out_of_range if the index is out of bounds.
+     * @throws std::length_error if the number of values does not match the number of rows.
+     */
+    void setColumn(size_t colIdx, std::shared_ptr<const ColumnBuffer> buffer) {
+        if (colIdx >= _columns.size()) {
+            throw std::out_of_range("Index out of range!");
+        }
+        if (buffer->size() != size()) {
+            throw std::length_error("Column size not matching with row size");
+        }
+        _columns[colIdx] = std::move(buffer);
+    }
+
+    /**
+     * @brief A lightweight view of one row, indexing it reads the columns directly.
+     */
+    class RowView {
+        const Data* data;
+        size_t rowIdx;
+
+       public:
+        RowView(const Data* data, size_t rowIdx) : data(data), rowIdx(rowIdx) {}
+
+        const _cdfVal& operator[](size_t colIdx) const { return data->cell(rowIdx, colIdx); }
+
+        size_t size() const { return data->colN; }
+    };
+
+    /**
+     * @brief Returns a view of the row at the specified index, without copying its values.
+     */
+    RowView row(size_t index) const { return RowView(this, index); }
 };
 }  // namespace core
 
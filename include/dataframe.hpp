@@ -2,45 +2,75 @@
 #define DATAFRAME_HPP
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <string>
 #include <vector>
 
 #include "data.hpp"
 #include "dtypes.hpp"
+#include "expr.hpp"
+#include "hashtable.hpp"
+#include "parallel.hpp"
+#include "sketch.hpp"
+#include "trace.hpp"
 #include "utils.hpp"
 #include "viz.hpp"
 
 namespace cdf {
 
+class LazyFrame;
+
+/**
+ * @brief Rows to keep when looking for duplicated rows.
+ */
+enum class DuplicateKeep {
+    First, /**< Keeps the first occurrence of every duplicated row */
+    Last,  /**< Keeps the last occurrence of every duplicated row */
+    None   /**< Keeps no occurrence of duplicated rows */
+};
+
 /**
  * @class DataFrame
  * @brief Represents a data structure similar to a table with rows and columns.
  *
  * The DataFrame class allows for operations similar to a DataFrame in Python's Pandas library,
  * including access to specific rows and columns, viewing the shape, and displaying the head and tail of the data.
+ *
+ * A DataFrame is not synchronized, see `LiveFrame` to query a frame from several threads while it grows.
  */
 class DataFrame {
     std::map<std::string, int> columnIndexMap; /**< Map to store column names and their respective indices */
     core::Data data;                           /**< Data storage object for rows of the DataFrame */
+    std::string indexColumn;                   /**< Column looked up by `loc`, empty until `set_index` */
+
+    friend class LazyFrame;
 
    public:
     std::vector<std::string> columns; /**< Column names in the DataFrame */
     /**
      * @brief Constructs a DataFrame with optional data and columns.
+     *
+     * The column buffers of `data` are shared, not copied.
+     *
      * @param data The data object to initialize the DataFrame with (default is an empty Data).
      * @param columns The column names for the DataFrame (default is an empty vector).
      */
-    DataFrame(core::Data data = {}, std::vector<std::string> columns = {}) : data(data), columns(columns) {
+    DataFrame(core::Data data = {}, std::vector<std::string> columns = {})
+        : data(std::move(data)), columns(std::move(columns)) {
         columnIndexMap.clear();
-        for (int i = 0; i < columns.size(); i++) {
-            columnIndexMap[columns[i]] = i;
+        for (int i = 0; i < this->columns.size(); i++) {
+            columnIndexMap[this->columns[i]] = i;
         }
     }
 
     /**
      * @brief Constructs a DataFrame with row-wise information, column names and data-types.
+     * Values already holding the requested type are stored as they are, strings of a rvalue `inputData` are moved.
+     * Numbers are converted directly, only strings are parsed. Nan-values stay nan-values.
+     *
      * @param inputData Vector of Vector of _cdfVal as row-sie information.
      * @param columns The column names for the DataFrame
      * @param dataTypes The DataType of the columns.
@@ -55,30 +85,15 @@ class DataFrame {
             columnIndexMap[columns[i]] = i;
         }
 
-        // Define a blank Data object
-        core::Data tmpData(columns.size());
-
-        // Parse data from inputData and fill as per given data-type
-        for (auto& row : inputData) {
-            std::vector<_cdfVal> tmpRow;
-            for (int i = 0; i < columns.size(); i++) {
-                switch (dataTypes[i]) {
-                    case cdfDTypes::Integer:
-                        tmpRow.push_back(std::stoi(toString(row[i])));
-                        break;
-                    case cdfDTypes::Double:
-                        tmpRow.push_back(std::stod(toString(row[i])));
-                        break;
-                    case cdfDTypes::String:
-                        tmpRow.push_back(toString(row[i]));
-                        break;
-                }
+        // Parse data from inputData column by column and fill as per given data-type
+        for (int i = 0; i < columns.size(); i++) {
+            std::vector<_cdfVal> column;
+            column.reserve(inputData.size());
+            for (auto& row : inputData) {
+                column.push_back(convertValue(std::move(row[i]), dataTypes[i]));
             }
-            tmpData.push_back(tmpRow);
+            data.addColumn(std::move(column));
         }
-
-        // Push generated data to actual data object
-        data = tmpData;
     }
 
     /**
@@ -115,6 +130,9 @@ class DataFrame {
 
     /**
      * @brief Returns Series object holidng column values
+     *
+     * The series shares the buffer of the column, nothing is copied.
+     *
      * @param columnName The name of the corresponding column
      */
     core::Series operator[](std::string columnName) {
@@ -122,12 +140,7 @@ class DataFrame {
             throw std::invalid_argument("[cdf][DataFrame] Column Not present");
         }
         int colIdx = columnIndexMap[columnName];
-        std::vector<_cdfVal> column;
-        for (int i = 0; i < data.size(); i++) {
-            column.push_back(data[i][colIdx]);
-        }
-
-        return cdf::core::Series(column);
+        return cdf::core::Series(data.columnBuffer(colIdx));
     };
 
     /**
@@ -135,18 +148,94 @@ class DataFrame {
      * @param filteredIndexes Filtered information to retrieve rows from the Dataframe
      */
     DataFrame operator[](std::vector<bool> filteredIndexes) {
-        std::vector<int> indices;
+        CDF_TRACE_SPAN(span, "DataFrame::filter_mask");
+        span.rowsIn(data.size());
+        core::ScratchVector<int> indices(core::scratchResource());
         for (int i = 0; i < filteredIndexes.size(); i++) {
             if (filteredIndexes[i])
                 indices.push_back(i);
         }
-        return filter(indices);
+        span.rowsOut(indices.size());
+        return filterRows(indices.data(), indices.size(), parallel::settings().execution);
+    }
+
+    /**
+     * @brief Retrieves a dataframe of the rows satisfying a column expression
+     *
+     * The expression is bound to the columns once, then evaluated for every row in a single pass, only the columns
+     * used by the expression are read. Values are copied once, into the result. Morsels of rows are evaluated in
+     * parallel.
+     *
+     * Example:
+     * ```
+     * df = df[(cdf::col("Age") > 25 && cdf::col("Department") == "Engineering") || !(cdf::col("Salary") < 90000)];
+     * ```
+     *
+     * @param condition A condition built from `cdf::col`, comparisons, `&&`, `||`, `!` and arithmetic
+     * @throws std::invalid_argument If the expression refers to a column which is not present
+     */
+    template <typename Condition, typename = std::enable_if_t<expr::is_bool_expr_v<Condition>>>
+    DataFrame operator[](const Condition& condition) {
+        CDF_TRACE_SPAN(span, "DataFrame::filter_expression");
+        span.rowsIn(data.size());
+        Condition bound = condition;
+        bound.bind(columnIndexMap);
+
+        // A comparison of an indexed column with a constant is answered by the index, without a scan
+        if constexpr (expr::ColumnComparison<Condition>::value) {
+            std::vector<int> rows;
+            const auto& buffer = data.columnBuffer(bound.left().columnPosition());
+            using Comparator = typename expr::ColumnComparison<Condition>::comparator;
+            if (buffer->lookupIndexed(_cdfVal(bound.right().constant()), Comparator{}, rows)) {
+                span.rowsOut(rows.size());
+                return filterRows(rows.data(), rows.size(), parallel::settings().execution);
+            }
+        }
+
+        core::ScratchVector<uint8_t> matched(data.size(), core::scratchResource());
+        if constexpr (expr::ColumnComparison<Condition>::value) {
+            // A column compared with a constant is scanned directly, chunks ruled out by the zone map are skipped
+            CDF_TRACE_PHASE(evaluate, "DataFrame::evaluate");
+            evaluate.rowsIn(data.size());
+            using Comparator = typename expr::ColumnComparison<Condition>::comparator;
+            const auto& buffer = data.columnBuffer(bound.left().columnPosition());
+            const auto& constant = bound.right().constant();
+            if constexpr (std::is_same_v<std::decay_t<decltype(constant)>, _cdfVal>) {
+                // Wide integer constants hold an int, or a double outside of the int range
+                if (std::holds_alternative<int>(constant)) {
+                    core::compareColumn(*buffer, std::get<int>(constant), Comparator{}, matched.data());
+                } else {
+                    core::compareColumn(*buffer, std::get<double>(constant), Comparator{}, matched.data());
+                }
+            } else {
+                core::compareColumn(*buffer, constant, Comparator{}, matched.data());
+            }
+        } else {
+            CDF_TRACE_PHASE(evaluate, "DataFrame::evaluate");
+            evaluate.rowsIn(data.size());
+            parallel::forEachMorsel(data.size(), [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    matched[i] = bound.test(data.row(i));
+                }
+            });
+        }
+
+        core::ScratchVector<int> indices(core::scratchResource());
+        for (size_t i = 0; i < matched.size(); i++) {
+            if (matched[i]) {
+                indices.push_back(i);
+            }
+        }
+        span.rowsOut(indices.size());
+        return filterRows(indices.data(), indices.size(), parallel::settings().execution);
     }
 
     /**
      * @brief Selects particular columns
      *
-     * Creates a slice of columns
+     * Creates a slice of columns, which share their buffers with this DataFrame. Selecting columns, including all
+     * of them in another order, costs O(number of columns), a buffer is only copied when one of its owners modifies
+     * it.
      *
      * @param fields A vector of string containing the required columns for the subset
      * @throws std::out_of_range If any column is not presnet in the current dataframe
@@ -154,6 +243,9 @@ class DataFrame {
      * @returns DataFrame consisting of the given columns
      */
     const DataFrame operator[](const std::vector<std::string> fields) {
+        CDF_TRACE_SPAN(span, "DataFrame::select");
+        span.rowsIn(data.size());
+        span.rowsOut(data.size());
         std::vector<int> validColumnIndexes;
 
         // Checks and stores column indexes for further data-gathering
@@ -166,16 +258,16 @@ class DataFrame {
             }
         }
 
-        core::Data tmpData(validColumnIndexes.size());
-        for (int i = 0; i < data.size(); i++) {
-            std::vector<_cdfVal> tmpRow;
-            for (auto& idx : validColumnIndexes) {
-                tmpRow.push_back(data[i][idx]);
-            }
-            tmpData.push_back(tmpRow);
+        core::Data tmpData;
+        for (auto& idx : validColumnIndexes) {
+            tmpData.addColumn(data.columnBuffer(idx));
         }
 
-        return DataFrame(tmpData, fields);
+        DataFrame result(tmpData, fields);
+        if (result.columnIndexMap.count(indexColumn)) {
+            result.indexColumn = indexColumn;
+        }
+        return result;
     };
 
     /**
@@ -193,6 +285,8 @@ class DataFrame {
      */
     const DataFrame iloc(size_t startRowIndex = 0, size_t endRowIndex = -1, std::string startColumnName = "",
                          std::string endColumnName = "") {
+        CDF_TRACE_SPAN(span, "DataFrame::iloc");
+        span.rowsIn(data.size());
         if (startColumnName == "") {
             startColumnName = columns[0];
         }
@@ -220,15 +314,11 @@ class DataFrame {
             throw std::out_of_range("[cdf][DataFrame] Indices are out of range!");
         }
 
-        core::Data tmpData(endColIdx - startColIdx + 1);
-        for (int i = startRowIndex; i <= endRowIndex; i++) {
-            core::Row _row(data[i]);
-            std::vector<_cdfVal> tmpRow;
-            for (int j = startColIdx; j <= endColIdx; j++) {
-                tmpRow.push_back(_row[j]);
-            }
-            core::Row newRow(tmpRow);
-            tmpData.push_back(newRow);
+        span.rowsOut(endRowIndex - startRowIndex + 1);
+        core::Data tmpData;
+        for (int j = startColIdx; j <= endColIdx; j++) {
+            tmpData.addColumn(gather(*data.columnBuffer(j), endRowIndex - startRowIndex + 1,
+                                     [startRowIndex](size_t k) { return startRowIndex + k; }));
         }
 
         return DataFrame(tmpData,
@@ -239,23 +329,825 @@ class DataFrame {
      * @brief Filters rows based on specified row indices.
      *
      * @param indexes A vector of row indices to filter.
+     * @param execution Copies morsels of rows on the thread pool when parallel (default is the global setting).
      * @return A new DataFrame containing only the rows specified by the indices.
      *
      * @throws std::out_of_range If any of the indices are out of range of the DataFrame.
      */
-    const DataFrame filter(const std::vector<int>& indexes) {
-        core::Data tmpData(columns.size());
-        for (auto idx : indexes) {
-            if (idx < 0 || idx >= data.size()) {
+    const DataFrame filter(const std::vector<int>& indexes, Execution execution = parallel::settings().execution) {
+        CDF_TRACE_SPAN(span, "DataFrame::filter");
+        span.rowsIn(data.size());
+        span.rowsOut(indexes.size());
+        return filterRows(indexes.data(), indexes.size(), execution);
+    }
+
+    /**
+     * @brief Adds a column, or replaces the values of an existing one.
+     *
+     * The column shares the buffer of the series, the existing columns are neither copied nor moved.
+     *
+     * Example:
+     * ```
+     * df.assign("Monthly", df["Salary"] / 12).assign("Senior", df["Age"] - 40);
+     * ```
+     *
+     * @param name The name of the column.
+     * @param values A series with one value per row.
+     * @return The DataFrame itself, so calls can be chained.
+     *
+     * @throws std::length_error If the series does not hold one value per row.
+     */
+    DataFrame& assign(const std::string& name, const core::Series& values) {
+        CDF_TRACE_SPAN(span, "DataFrame::assign");
+        span.rowsIn(values.size());
+        if (!columns.empty() && values.size() != data.size()) {
+            throw std::length_error("[cdf][DataFrame] Column size not matching with row size");
+        }
+
+        auto it = columnIndexMap.find(name);
+        if (it != columnIndexMap.end()) {
+            data.setColumn(it->second, values.values());
+        } else {
+            data.addColumn(values.values());
+            columnIndexMap[name] = columns.size();
+            columns.push_back(name);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Renames columns.
+     *
+     * The result shares every column buffer with this DataFrame, only the names are copied.
+     *
+     * @param mapping Pairs of (current name, new name), columns which are not listed keep their name.
+     * @return A DataFrame with the renamed columns.
+     *
+     * @throws std::out_of_range If a current name is not present in the DataFrame.
+     * @throws std::invalid_argument If two columns would end up with the same name.
+     */
+    DataFrame rename(const std::map<std::string, std::string>& mapping) const {
+        CDF_TRACE_SPAN(span, "DataFrame::rename");
+        std::vector<std::string> renamed = columns;
+        for (auto& [from, to] : mapping) {
+            auto it = columnIndexMap.find(from);
+            if (it == columnIndexMap.end()) {
+                std::string errorMessage = "[cdf][DataFrame] " + from + " not present inside dataframe object!";
+                throw std::out_of_range(errorMessage);
+            }
+            renamed[it->second] = to;
+        }
+
+        DataFrame result(data, renamed);
+        if (result.columnIndexMap.size() != renamed.size()) {
+            throw std::invalid_argument("[cdf][DataFrame] Column names should be unique after renaming");
+        }
+        if (!indexColumn.empty()) {
+            result.indexColumn = renamed[columnIndexMap.at(indexColumn)];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Appends the rows of another DataFrame, matching the columns by name.
+     *
+     * The column buffers of `other` are shared as chunks and the rows already held are never moved, so appending
+     * costs the number of chunks, not the number of rows. Batches smaller than `core::ColumnBuffer::chunkRows` are
+     * merged into the last chunk while it is small. Appending to a DataFrame without columns adopts the columns of
+     * `other`.
+     *
+     * Example:
+     * ```
+     * cdf::DataFrame events;
+     * while (auto batch = nextBatch()) {
+     *     events.append(*batch);
+     * }
+     * ```
+     *
+     * @param other The DataFrame holding the rows to append.
+     * @return The DataFrame itself, so calls can be chained.
+     *
+     * @throws std::invalid_argument If the columns of the frames differ.
+     */
+    DataFrame& append(const DataFrame& other) {
+        CDF_TRACE_SPAN(span, "DataFrame::append");
+        span.rowsIn(other.data.size());
+        if (columns.empty() && data.size() == 0) {
+            *this = DataFrame(other.data, other.columns);
+            span.rowsOut(data.size());
+            return *this;
+        }
+        if (other.columns.size() != columns.size()) {
+            throw std::invalid_argument("[cdf][DataFrame] Appended frame has different columns");
+        }
+        std::vector<std::shared_ptr<const core::ColumnBuffer>> buffers;
+        for (auto& column : columns) {
+            auto it = other.columnIndexMap.find(column);
+            if (it == other.columnIndexMap.end()) {
+                throw std::invalid_argument("[cdf][DataFrame] Appended frame has different columns");
+            }
+            buffers.push_back(other.data.columnBuffer(it->second));
+        }
+        data.append(buffers);
+        span.rowsOut(data.size());
+        return *this;
+    }
+
+    /**
+     * @brief Reports the memory held by every column.
+     *
+     * Shallow usage counts the variant slots of the values, unused capacity included, and the encoded values of
+     * compressed columns. Deep usage adds the heap blocks of strings too long for the small string buffer and the
+     * typed and string representations cached so far.
+     * Buffers shared with other DataFrames or Series are reported in full by each of them.
+     *
+     * @param deep Counts the memory held outside of the variant slots (default is true).
+     * @return A DataFrame with a `column` column naming each column and a `bytes` column.
+     */
+    DataFrame memory_usage(bool deep = true) const {
+        core::Data usage(2);
+        for (size_t j = 0; j < columns.size(); j++) {
+            size_t bytes = data.columnBuffer(j)->memoryBytes(deep);
+            if (bytes <= static_cast<size_t>(std::numeric_limits<int>::max())) {
+                usage.emplace_row(columns[j], static_cast<int>(bytes));
+            } else {
+                usage.emplace_row(columns[j], static_cast<double>(bytes));
+            }
+        }
+        return DataFrame(usage, {"column", "bytes"});
+    }
+
+    /**
+     * @brief Adds a column computed from a column expression, or replaces the values of an existing one.
+     *
+     * Example:
+     * ```
+     * df.assign("Bonus", cdf::col("Salary") * 0.1 + 500);
+     * ```
+     *
+     * @param name The name of the column.
+     * @param expression A value expression built from `cdf::col`, constants and arithmetic.
+     * @return The DataFrame itself, so calls can be chained.
+     *
+     * @throws std::invalid_argument If the expression refers to a column which is not present.
+     */
+    template <typename Expression, typename = std::enable_if_t<expr::is_value_expr_v<Expression>>>
+    DataFrame& assign(const std::string& name, const Expression& expression) {
+        CDF_TRACE_SPAN(span, "DataFrame::assign_expression");
+        span.rowsIn(data.size());
+        span.rowsOut(data.size());
+        Expression bound = expression;
+        bound.bind(columnIndexMap);
+
+        std::vector<_cdfVal> column(data.size());
+        {
+            CDF_TRACE_PHASE(evaluate, "DataFrame::evaluate");
+            evaluate.rowsIn(data.size());
+            parallel::forEachMorsel(data.size(), [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    column[i] = _cdfVal(bound.eval(data.row(i)));
+                }
+            });
+        }
+        return assign(name, core::Series(column));
+    }
+
+    /**
+     * @brief Builds a secondary index over a column.
+     *
+     * Comparisons of the column with a constant, through `df[cdf::col("id") == 42]` or the `Series` comparison
+     * operators, are then answered by the index instead of a scan: a hash index answers equality in O(1), a sorted
+     * index equality and ranges in O(log n). The index belongs to the column buffer, so projections and renamed
+     * frames sharing the column use it too; replacing or modifying the column drops it.
+     *
+     * @param column The column to index.
+     * @param kind The kind of index (default is IndexKind::Hash).
+     * @return The DataFrame itself, so calls can be chained.
+     *
+     * @throws std::invalid_argument If the column is not present or mixes strings and numbers.
+     */
+    DataFrame& create_index(const std::string& column, IndexKind kind = IndexKind::Hash) {
+        CDF_TRACE_SPAN(span, "DataFrame::create_index");
+        span.rowsIn(data.size());
+        data.columnBuffer(columnPosition(column))->buildIndex(kind);
+        return *this;
+    }
+
+    /**
+     * @brief Indexes a column and makes it the key looked up by `loc`.
+     *
+     * Example:
+     * ```
+     * df.set_index("PassengerId");
+     * auto passenger = df.loc(42);
+     * ```
+     *
+     * @param column The key column.
+     * @param kind The kind of index (default is IndexKind::Hash, use IndexKind::Sorted for range lookups).
+     * @return The DataFrame itself, so calls can be chained.
+     *
+     * @throws std::invalid_argument If the column is not present or mixes strings and numbers.
+     */
+    DataFrame& set_index(const std::string& column, IndexKind kind = IndexKind::Hash) {
+        create_index(column, kind);
+        indexColumn = column;
+        return *this;
+    }
+
+    /**
+     * @brief Drops the indexes of a column, and the `loc` key if it was this column.
+     *
+     * @throws std::invalid_argument If the column is not present.
+     */
+    DataFrame& drop_index(const std::string& column) {
+        const auto& buffer = data.columnBuffer(columnPosition(column));
+        buffer->dropIndex(IndexKind::Hash);
+        buffer->dropIndex(IndexKind::Sorted);
+        if (indexColumn == column) {
+            indexColumn.clear();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Returns whether a column has an index of the given kind.
+     *
+     * @throws std::invalid_argument If the column is not present.
+     */
+    bool has_index(const std::string& column, IndexKind kind = IndexKind::Hash) const {
+        return data.columnBuffer(columnPosition(column))->hasIndex(kind);
+    }
+
+    /**
+     * @brief Stores a column in a compact in-memory encoding.
+     *
+     * Frame-of-reference and delta encodings apply to columns of integers and nan-values, run-length encoding to any
+     * column. Comparisons with a constant, `sum`, `mean` and `count` run on the encoded values, other reductions
+     * decode them into a typed buffer. Accessing the values row by row (printing, filtering rows, `iloc`) decodes the
+     * variants once and keeps them next to the encoded form. Other frames sharing the column keep the plain values,
+     * and the indexes of the column are dropped.
+     *
+     * Example:
+     * ```
+     * df.compress("PassengerId", cdf::Encoding::Delta);
+     * df.compress("Pclass");  // the smallest encoding, if one saves memory
+     * ```
+     *
+     * @param column The column to encode.
+     * @param encoding The encoding (default is Encoding::Auto), Encoding::Plain decodes the column.
+     * @return The DataFrame itself, so calls can be chained.
+     *
+     * @throws std::invalid_argument If the column is not present or the encoding does not apply to its values.
+     */
+    DataFrame& compress(const std::string& column, Encoding encoding = Encoding::Auto) {
+        CDF_TRACE_SPAN(span, "DataFrame::compress");
+        span.rowsIn(data.size());
+        size_t colIdx = columnPosition(column);
+        const auto& buffer = data.columnBuffer(colIdx);
+        if (encoding != Encoding::Auto && buffer->encoding() == encoding) {
+            return *this;
+        }
+
+        // Encoded columns are decoded aside, so the buffer shared with other frames stays compact
+        std::vector<_cdfVal> decodedValues;
+        if (buffer->encodedColumn()) {
+            decodedValues = buffer->encodedColumn()->decode();
+        }
+        const std::vector<_cdfVal>& values = buffer->encodedColumn() ? decodedValues : buffer->values();
+
+        auto encoded = core::EncodedColumn::encode(values, encoding);
+        if (encoded) {
+            data.setColumn(colIdx, core::ColumnBuffer::create(std::move(encoded)));
+        } else if (encoding != Encoding::Plain && encoding != Encoding::Auto) {
+            throw std::invalid_argument("[cdf][DataFrame] Column " + column + " cannot be stored in this encoding");
+        } else if (buffer->encodedColumn()) {
+            data.setColumn(colIdx, core::ColumnBuffer::create(std::move(decodedValues)));
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Stores every column in its smallest encoding, columns no encoding saves memory for stay plain.
+     *
+     * @return The DataFrame itself, so calls can be chained.
+     */
+    DataFrame& compress() {
+        for (auto& column : columns) {
+            compress(column);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Returns the encoding of a column.
+     *
+     * @throws std::invalid_argument If the column is not present.
+     */
+    Encoding encoding(const std::string& column) const {
+        return data.columnBuffer(columnPosition(column))->encoding();
+    }
+
+    /**
+     * @brief Selects the rows whose key, the column given to `set_index`, equals a value.
+     *
+     * @param key An integer, floating point or string value.
+     * @return A DataFrame of the matching rows, in row order.
+     *
+     * @throws std::runtime_error If no key column was set.
+     */
+    template <typename T>
+    DataFrame loc(const T& key) {
+        CDF_TRACE_SPAN(span, "DataFrame::loc");
+        span.rowsIn(data.size());
+        int colIdx = keyPosition();
+        std::vector<int> rows;
+        _cdfVal probe = probeOf(key);
+        if (!data.columnBuffer(colIdx)->lookupIndexed(probe, std::equal_to<>{}, rows)) {
+            rows = scanRows(colIdx, [&](const _cdfVal& value) {
+                return expr::compareOperands(value, probe, std::equal_to<>{});
+            });
+        }
+        span.rowsOut(rows.size());
+        return filterRows(rows.data(), rows.size(), parallel::settings().execution);
+    }
+
+    /**
+     * @brief Selects the rows whose key, the column given to `set_index`, lies in [low, high].
+     *
+     * Answered by binary search when the key has a sorted index, by a scan otherwise.
+     *
+     * @return A DataFrame of the matching rows, in row order.
+     *
+     * @throws std::runtime_error If no key column was set.
+     */
+    template <typename T>
+    DataFrame loc(const T& low, const T& high) {
+        CDF_TRACE_SPAN(span, "DataFrame::loc");
+        span.rowsIn(data.size());
+        int colIdx = keyPosition();
+        std::vector<int> rows;
+        _cdfVal lowProbe = probeOf(low), highProbe = probeOf(high);
+        if (!data.columnBuffer(colIdx)->lookupBetween(lowProbe, highProbe, rows)) {
+            rows = scanRows(colIdx, [&](const _cdfVal& value) {
+                return expr::compareOperands(value, lowProbe, std::greater_equal<>{}) &&
+                       expr::compareOperands(value, highProbe, std::less_equal<>{});
+            });
+        }
+        span.rowsOut(rows.size());
+        return filterRows(rows.data(), rows.size(), parallel::settings().execution);
+    }
+
+    /**
+     * @brief Starts a lazy query over the DataFrame.
+     *
+     * The returned LazyFrame records filter/select/sort/limit/aggregate steps and executes them as one optimized
+     * pipeline on `collect()`. The DataFrame has to outlive the LazyFrame.
+     */
+    LazyFrame lazy();
+
+    /**
+     * @brief Generates summary statistics of every numeric column.
+     *
+     * Computes count, null count, mean, standard deviation, min, max and approximate quartiles of all the numeric
+     * columns in one pass over the rows. Morsels of rows are scanned on the thread pool, their partial summaries
+     * (Welford moments and t-digests) are merged in morsel order at the end. Columns holding string values are
+     * skipped.
+     *
+     * @param execution Scans the morsels on the thread pool when parallel (default is the global setting).
+     * @return A DataFrame with a `stat` column naming each statistic and one column per numeric column.
+     */
+    DataFrame describe(Execution execution = parallel::settings().execution) {
+        CDF_TRACE_SPAN(span, "DataFrame::describe");
+        span.rowsIn(data.size());
+        struct ColumnSummary {
+            bool numeric = true;
+            int count = 0;
+            int nullCount = 0;
+            double mean = 0, m2 = 0;
+            double min = 0, max = 0;
+            sketch::TDigest digest;
+
+            void add(double value) {
+                ++count;
+                double delta = value - mean;
+                mean += delta / count;
+                m2 += delta * (value - mean);
+                min = count == 1 ? value : std::min(min, value);
+                max = count == 1 ? value : std::max(max, value);
+                digest.add(value);
+            }
+
+            void merge(const ColumnSummary& other) {
+                numeric = numeric && other.numeric;
+                nullCount += other.nullCount;
+                if (other.count == 0) {
+                    return;
+                }
+                if (count == 0) {
+                    min = other.min;
+                    max = other.max;
+                } else {
+                    min = std::min(min, other.min);
+                    max = std::max(max, other.max);
+                }
+                // Chan et al. parallel combination of the moments
+                int total = count + other.count;
+                double delta = other.mean - mean;
+                mean += delta * other.count / total;
+                m2 += other.m2 + delta * delta * count * other.count / total;
+                count = total;
+                digest.merge(other.digest);
+            }
+        };
+
+        size_t numMorsels = std::max<size_t>(1, parallel::morselCount(data.size()));
+        std::vector<std::vector<ColumnSummary>> partials(numMorsels, std::vector<ColumnSummary>(columns.size()));
+        auto scanRows = [&](size_t part, size_t start, size_t end) {
+            std::vector<ColumnSummary>& summaries = partials[part];
+            for (size_t j = 0; j < summaries.size(); j++) {
+                data.columnBuffer(j)->forEachValue(start, end, [&](size_t, const _cdfVal& value) {
+                    if (std::holds_alternative<int>(value)) {
+                        summaries[j].add(std::get<int>(value));
+                    } else if (std::holds_alternative<double>(value)) {
+                        summaries[j].add(std::get<double>(value));
+                    } else if (std::holds_alternative<NaN>(value)) {
+                        ++summaries[j].nullCount;
+                    } else {
+                        summaries[j].numeric = false;
+                    }
+                });
+            }
+        };
+
+        parallel::forEachMorsel(data.size(), scanRows, execution);
+        for (size_t part = 1; part < numMorsels; part++) {
+            for (size_t j = 0; j < columns.size(); j++) {
+                partials[0][j].merge(partials[part][j]);
+            }
+        }
+
+        // Lay the statistics out as rows, one column per numeric column
+        std::vector<std::string> statNames = {"count", "null_count", "mean", "std", "min", "25%", "50%", "75%", "max"};
+        std::vector<std::string> resultColumns = {"stat"};
+        std::vector<std::vector<_cdfVal>> resultRows(statNames.size());
+        for (size_t k = 0; k < statNames.size(); k++) {
+            resultRows[k].push_back(statNames[k]);
+        }
+
+        for (size_t j = 0; j < columns.size(); j++) {
+            const ColumnSummary& summary = partials[0][j];
+            if (!summary.numeric) {
+                continue;
+            }
+            resultColumns.push_back(columns[j]);
+            bool empty = summary.count == 0;
+            resultRows[0].push_back(summary.count);
+            resultRows[1].push_back(summary.nullCount);
+            resultRows[2].push_back(empty ? _cdfVal(NaN()) : _cdfVal(summary.mean));
+            resultRows[3].push_back(summary.count < 2 ? _cdfVal(NaN())
+                                                      : _cdfVal(std::sqrt(summary.m2 / (summary.count - 1))));
+            resultRows[4].push_back(empty ? _cdfVal(NaN()) : _cdfVal(summary.min));
+            resultRows[5].push_back(empty ? _cdfVal(NaN()) : _cdfVal(summary.digest.quantile(0.25)));
+            resultRows[6].push_back(empty ? _cdfVal(NaN()) : _cdfVal(summary.digest.quantile(0.5)));
+            resultRows[7].push_back(empty ? _cdfVal(NaN()) : _cdfVal(summary.digest.quantile(0.75)));
+            resultRows[8].push_back(empty ? _cdfVal(NaN()) : _cdfVal(summary.max));
+        }
+
+        core::Data result(resultColumns.size());
+        for (auto& row : resultRows) {
+            result.push_back(row);
+        }
+        return DataFrame(result, resultColumns);
+    }
+
+    /**
+     * @brief Flags duplicated rows.
+     *
+     * @param subset Columns used to compare rows (default is all the columns).
+     * @param keep Occurrence which is not flagged as a duplicate (default is the first one).
+     * @param parallel Splits the rows into hash partitions deduplicated on the thread pool (default is false).
+     * @return A vector of boolean values, true for every row flagged as a duplicate.
+     *
+     * @throws std::out_of_range If any column of the subset is not present in the DataFrame.
+     */
+    std::vector<bool> duplicated(const std::vector<std::string>& subset = {},
+                                 DuplicateKeep keep = DuplicateKeep::First, bool parallel = false) {
+        CDF_TRACE_SPAN(span, "DataFrame::duplicated");
+        span.rowsIn(data.size());
+        span.rowsOut(data.size());
+        core::ScratchVector<uint8_t> kept = markKeptRows(subset, keep, parallel);
+        std::vector<bool> truth(kept.size());
+        for (size_t i = 0; i < kept.size(); i++) {
+            truth[i] = !kept[i];
+        }
+        return truth;
+    }
+
+    /**
+     * @brief Selects the rows remaining once duplicated rows are dropped.
+     *
+     * Rows are hashed over the subset columns and grouped in an open-addressing hash table, no row is copied. The
+     * returned selection can be materialized with `filter`.
+     *
+     * @param subset Columns used to compare rows (default is all the columns).
+     * @param keep Occurrence of duplicated rows to keep (default is the first one).
+     * @param parallel Splits the rows into hash partitions deduplicated on the thread pool (default is false).
+     * @return The indices of the remaining rows in ascending order.
+     *
+     * @throws std::out_of_range If any column of the subset is not present in the DataFrame.
+     */
+    std::vector<int> drop_duplicates(const std::vector<std::string>& subset = {},
+                                     DuplicateKeep keep = DuplicateKeep::First, bool parallel = false) {
+        CDF_TRACE_SPAN(span, "DataFrame::drop_duplicates");
+        span.rowsIn(data.size());
+        core::ScratchVector<uint8_t> kept = markKeptRows(subset, keep, parallel);
+        std::vector<int> indices;
+        for (size_t i = 0; i < kept.size(); i++) {
+            if (kept[i]) {
+                indices.push_back(i);
+            }
+        }
+        span.rowsOut(indices.size());
+        return indices;
+    }
+
+   private:
+    /**
+     * @brief Returns the position of a column
+     *
+     * @throws std::invalid_argument If the column is not present
+     */
+    int columnPosition(const std::string& column) const {
+        auto it = columnIndexMap.find(column);
+        if (it == columnIndexMap.end()) {
+            throw std::invalid_argument("[cdf][DataFrame] Column " + column + " Not present");
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Returns the position of the key column of `loc`
+     *
+     * @throws std::runtime_error If no key column was set
+     */
+    int keyPosition() const {
+        if (indexColumn.empty()) {
+            throw std::runtime_error("[cdf][DataFrame] No index set, call set_index first");
+        }
+        return columnPosition(indexColumn);
+    }
+
+    /**
+     * @brief Converts a lookup key to a variant value: integers to int, floating points to double, others to string
+     *
+     * Integers outside of the `int` range are converted to double, as they are stored when read.
+     */
+    template <typename T>
+    static _cdfVal probeOf(const T& key) {
+        if constexpr (std::is_integral_v<T>) {
+            return kernels::integerValue(key);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<double>(key);
+        } else {
+            return std::string(key);
+        }
+    }
+
+    /**
+     * @brief Returns the rows of a column whose value satisfies a predicate, morsels are scanned in parallel
+     */
+    template <typename Predicate>
+    std::vector<int> scanRows(int colIdx, const Predicate& predicate) const {
+        const core::ColumnBuffer& column = *data.columnBuffer(colIdx);
+        core::ScratchVector<uint8_t> matched(column.size(), core::scratchResource());
+        parallel::forEachMorsel(column.size(), [&](size_t, size_t begin, size_t end) {
+            column.forEachValue(begin, end, [&](size_t i, const _cdfVal& value) { matched[i] = predicate(value); });
+        });
+        std::vector<int> rows;
+        for (size_t i = 0; i < matched.size(); i++) {
+            if (matched[i]) {
+                rows.push_back(i);
+            }
+        }
+        return rows;
+    }
+
+    /**
+     * @brief Copies the given rows into a new DataFrame, see `filter`
+     */
+    DataFrame filterRows(const int* indexes, size_t n, Execution execution) {
+        for (size_t k = 0; k < n; k++) {
+            if (indexes[k] < 0 || static_cast<size_t>(indexes[k]) >= data.size()) {
                 throw std::out_of_range("[cdf][DataFrame] Index is out of range!");
             }
-            core::Row _row = data[idx];
-            tmpData.push_back(_row);
+        }
+
+        // Gathers column by column, each pass reads a single column
+        CDF_TRACE_PHASE(span, "DataFrame::gather");
+        span.rowsIn(data.size());
+        span.rowsOut(n);
+        core::Data tmpData;
+        for (int j = 0; j < data.colN; j++) {
+            tmpData.addColumn(gather(*data.columnBuffer(j), n, [indexes](size_t k) { return indexes[k]; }, execution));
         }
         return DataFrame(tmpData, columns);
     }
+
+    /**
+     * @brief Converts a value to a data-type, nan-values are kept
+     */
+    static _cdfVal convertValue(_cdfVal&& value, cdfDTypes dataType) {
+        if (std::holds_alternative<NaN>(value)) {
+            return value;
+        }
+        switch (dataType) {
+            case cdfDTypes::Integer:
+                if (std::holds_alternative<int>(value)) {
+                    return value;
+                } else if (std::holds_alternative<double>(value)) {
+                    return static_cast<int>(std::get<double>(value));
+                }
+                return std::stoi(std::get<std::string>(value));
+            case cdfDTypes::Double:
+                if (std::holds_alternative<double>(value)) {
+                    return value;
+                } else if (std::holds_alternative<int>(value)) {
+                    return static_cast<double>(std::get<int>(value));
+                }
+                return std::stod(std::get<std::string>(value));
+            case cdfDTypes::String:
+                if (std::holds_alternative<std::string>(value)) {
+                    return std::move(value);
+                }
+                return toString(value);
+        }
+        return value;
+    }
+
+    /**
+     * @brief Copies the value of row `indexOf(k)` of a column for every k in [0, n), morsels of values are copied in
+     * parallel. The rows of a chunked column are read from their chunks, which are never gathered.
+     */
+    template <typename IndexOf>
+    static std::vector<_cdfVal> gather(const core::ColumnBuffer& column, size_t n, const IndexOf& indexOf,
+                                       Execution execution = parallel::settings().execution) {
+        std::vector<_cdfVal> values(n);
+        const std::vector<_cdfVal>* flat = column.chunked() ? nullptr : &column.values();
+        parallel::forEachMorsel(
+            n,
+            [&](size_t, size_t begin, size_t end) {
+                for (size_t k = begin; k < end; k++) {
+                    values[k] = flat ? (*flat)[indexOf(k)] : column.at(indexOf(k));
+                }
+            },
+            execution);
+        return values;
+    }
+
+    /**
+     * @brief Marks the rows kept by a deduplication over the given columns
+     */
+    core::ScratchVector<uint8_t> markKeptRows(const std::vector<std::string>& subset, DuplicateKeep keep,
+                                              bool partitioned) {
+        std::vector<int> keyColumns;
+        for (auto& field : subset) {
+            if (columnIndexMap.find(field) == columnIndexMap.end()) {
+                std::string errorMessage = "[cdf][DataFrame] " + field + " not present inside dataframe object!";
+                throw std::out_of_range(errorMessage);
+            }
+            keyColumns.push_back(columnIndexMap[field]);
+        }
+        if (subset.empty()) {
+            for (size_t j = 0; j < columns.size(); j++) {
+                keyColumns.push_back(j);
+            }
+        }
+
+        size_t n = data.size();
+        core::ScratchVector<uint64_t> rowHashes(n, keyColumns.size(), core::scratchResource());
+        {
+            CDF_TRACE_PHASE(span, "DataFrame::hash_rows");
+            span.rowsIn(n);
+            parallel::forEachMorsel(n, [&](size_t, size_t begin, size_t end) {
+                for (int col : keyColumns) {
+                    data.columnBuffer(col)->forEachValue(begin, end, [&](size_t i, const _cdfVal& value) {
+                        rowHashes[i] = mixHash(rowHashes[i] ^ hashValue(value));
+                    });
+                }
+            });
+        }
+
+        struct RowHash {
+            const uint64_t* hashes;
+            uint64_t operator()(size_t row) const { return hashes[row]; }
+        };
+        struct RowEqual {
+            const core::Data* data;
+            const std::vector<int>* keyColumns;
+            bool operator()(size_t lhs, size_t rhs) const {
+                for (int col : *keyColumns) {
+                    if (!valueEquals(data->cell(lhs, col), data->cell(rhs, col))) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        };
+
+        // Rows of one partition never match rows of another one, so partitions are deduplicated independently
+        size_t numParts = 1;
+        if (partitioned) {
+            numParts = std::max<size_t>(1, std::min(get_num_threads(), parallel::morselCount(n)));
+        }
+
+        core::ScratchVector<uint8_t> kept(n, 0, core::scratchResource());
+        auto dedupPartition = [&](size_t part) {
+            core::OpenHashMap<size_t, size_t, RowHash, RowEqual> groups(numParts == 1 ? n : n / numParts,
+                                                                         RowHash{rowHashes.data()},
+                                                                         RowEqual{&data, &keyColumns});
+            auto visit = [&](size_t row) {
+                if (numParts > 1 && (rowHashes[row] >> 32) % numParts != part) {
+                    return;
+                }
+                auto [entry, inserted] = groups.insert(row, 0);
+                ++groups.value(entry);
+                if (inserted && keep != DuplicateKeep::None) {
+                    kept[row] = 1;
+                }
+            };
+
+            if (keep == DuplicateKeep::Last) {
+                for (size_t row = n; row-- > 0;) {
+                    visit(row);
+                }
+            } else {
+                for (size_t row = 0; row < n; row++) {
+                    visit(row);
+                }
+            }
+
+            if (keep == DuplicateKeep::None) {
+                for (size_t row = 0; row < n; row++) {
+                    if (numParts > 1 && (rowHashes[row] >> 32) % numParts != part) {
+                        continue;
+                    }
+                    kept[row] = groups.value(groups.find(row)) == 1;
+                }
+            }
+        };
+
+        CDF_TRACE_PHASE(span, "DataFrame::group_rows");
+        span.rowsIn(n);
+        parallel::runTasks(numParts, dedupPartition);
+        return kept;
+    }
 };
 
+/**
+ * @brief Concatenates the rows of DataFrames, matching the columns by name, in the order of the first frame.
+ *
+ * Nothing is copied: the column buffers of every frame are shared as chunks of the result, so the cost is the number
+ * of chunks, not the number of rows. See `DataFrame::append`.
+ *
+ * @param frames The DataFrames to concatenate, in order.
+ * @return A DataFrame holding the rows of every frame, empty if there is none.
+ *
+ * @throws std::invalid_argument If the columns of the frames differ.
+ */
+DataFrame concat(const std::vector<DataFrame>& frames) {
+    CDF_TRACE_SPAN(span, "DataFrame::concat");
+    DataFrame result;
+    for (auto& frame : frames) {
+        result.append(frame);
+    }
+    span.rowsIn(result.shape().first);
+    span.rowsOut(result.shape().first);
+    return result;
+}
+
+inline DataFrame core::Series::value_counts(bool sort, size_t topK) const {
+    CDF_TRACE_SPAN(span, "Series::value_counts");
+    span.rowsIn(size());
+    std::vector<std::pair<size_t, uint64_t>> counts = countDistinct();
+
+    auto byCount = [](const std::pair<size_t, uint64_t>& a, const std::pair<size_t, uint64_t>& b) {
+        return a.second > b.second || (a.second == b.second && a.first < b.first);
+    };
+    if (topK > 0 && topK < counts.size()) {
+        std::partial_sort(counts.begin(), counts.begin() + topK, counts.end(), byCount);
+        counts.resize(topK);
+    } else if (sort) {
+        std::sort(counts.begin(), counts.end(), byCount);
+    }
+
+    core::Data result(2);
+    for (auto& [firstIdx, count] : counts) {
+        std::vector<_cdfVal> row = {buffer->at(firstIdx), static_cast<int>(count)};
+        result.push_back(row);
+    }
+    return DataFrame(result, {"value", "count"});
+}
+
 }  // namespace cdf
 
 #endif
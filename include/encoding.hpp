@@ -0,0 +1,356 @@
+#ifndef ENCODING_HPP
+#define ENCODING_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "dtypes.hpp"
+#include "kernels.hpp"
+
+namespace cdf {
+
+/**
+ * @brief In-memory encoding of a column.
+ */
+enum class Encoding {
+    Plain,            /**< One variant per value */
+    FrameOfReference, /**< Integers stored as bit-packed offsets from the column minimum */
+    RunLength,        /**< One value per run of equal values, for sorted or repetitive columns */
+    Delta,            /**< Bit-packed differences between consecutive integers, for ids and timestamps */
+    Auto              /**< The smallest applicable encoding, Plain if none saves memory */
+};
+
+namespace core {
+
+/**
+ * @class PackedInts
+ * @brief Integers stored as fixed-width offsets from their minimum, packed into 64-bit words.
+ */
+class PackedInts {
+    int64_t reference = 0;
+    unsigned width = 0;
+    std::vector<uint64_t> words;
+
+   public:
+    PackedInts() = default;
+
+    /**
+     * @brief Packs the given integers with the width of their range.
+     */
+    explicit PackedInts(const std::vector<int64_t>& values) {
+        if (values.empty()) {
+            return;
+        }
+        auto [low, high] = std::minmax_element(values.begin(), values.end());
+        reference = *low;
+        uint64_t range = static_cast<uint64_t>(*high) - static_cast<uint64_t>(*low);
+        while (width < 64 && (range >> width) != 0) {
+            width++;
+        }
+        // One spare word, so reading a value never checks for the end
+        words.assign((values.size() * width + 63) / 64 + 1, 0);
+        for (size_t i = 0; i < values.size(); i++) {
+            uint64_t code = static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(reference);
+            size_t bit = i * width;
+            words[bit >> 6] |= code << (bit & 63);
+            if ((bit & 63) + width > 64) {
+                words[(bit >> 6) + 1] |= code >> (64 - (bit & 63));
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the i-th integer.
+     */
+    int64_t operator[](size_t i) const {
+        if (width == 0) {
+            return reference;
+        }
+        size_t bit = i * width;
+        size_t offset = bit & 63;
+        uint64_t code = words[bit >> 6] >> offset;
+        if (offset + width > 64) {
+            code |= words[(bit >> 6) + 1] << (64 - offset);
+        }
+        if (width < 64) {
+            code &= (uint64_t(1) << width) - 1;
+        }
+        return static_cast<int64_t>(code + static_cast<uint64_t>(reference));
+    }
+
+    unsigned bitWidth() const { return width; }
+
+    size_t memoryBytes() const { return words.capacity() * sizeof(uint64_t); }
+};
+
+/**
+ * @class EncodedColumn
+ * @brief The values of a column in a compact encoding, immutable once built.
+ *
+ * Frame-of-reference and delta encodings apply to columns of integers and nan-values, nan-values being flagged in a
+ * bitmap. Run-length encoding applies to any column. Comparisons and sums read the encoded form directly, see
+ * `compareEncoded`, other operations decode it.
+ */
+class EncodedColumn {
+    Encoding kind = Encoding::Plain;
+    size_t rows = 0;
+    size_t nulls = 0;
+
+    // Frame of reference and delta
+    std::vector<uint64_t> nullBits; /**< Bit set for a nan-value, empty without nan-values */
+    PackedInts packed;              /**< Values, or differences with the previous row for delta */
+    std::vector<int64_t> blockBase; /**< Delta: value at the start of each block */
+
+    // Run length: run r covers the rows [ends[r - 1], ends[r])
+    std::vector<_cdfVal> runValues;
+    std::vector<uint32_t> ends;
+
+    static size_t variantBytes(const std::vector<_cdfVal>& values) {
+        size_t bytes = values.capacity() * sizeof(_cdfVal);
+        for (auto& value : values) {
+            if (std::holds_alternative<std::string>(value) && std::get<std::string>(value).capacity() > 15) {
+                bytes += std::get<std::string>(value).capacity() + 1;
+            }
+        }
+        return bytes;
+    }
+
+   public:
+    static constexpr size_t blockRows = 1 << 16; /**< Rows decoded independently, in parallel */
+
+    /**
+     * @brief Encodes values, nullptr if the encoding does not apply to them.
+     *
+     * `Encoding::Auto` picks the smallest applicable encoding and returns nullptr when none is smaller than the
+     * variants.
+     */
+    static std::shared_ptr<const EncodedColumn> encode(const std::vector<_cdfVal>& values, Encoding encoding) {
+        if (encoding == Encoding::Plain || values.size() > std::numeric_limits<uint32_t>::max()) {
+            return nullptr;
+        }
+        if (encoding == Encoding::Auto) {
+            std::shared_ptr<const EncodedColumn> best;
+            size_t bestBytes = variantBytes(values);
+            for (Encoding candidate : {Encoding::FrameOfReference, Encoding::Delta, Encoding::RunLength}) {
+                auto encoded = encode(values, candidate);
+                if (encoded && encoded->memoryBytes() < bestBytes) {
+                    bestBytes = encoded->memoryBytes();
+                    best = encoded;
+                }
+            }
+            return best;
+        }
+
+        auto column = std::make_shared<EncodedColumn>();
+        column->kind = encoding;
+        column->rows = values.size();
+        if (encoding == Encoding::RunLength) {
+            for (size_t i = 0; i < values.size(); i++) {
+                if (column->runValues.empty() || !sameValue(column->runValues.back(), values[i])) {
+                    column->runValues.push_back(values[i]);
+                    column->ends.push_back(i);
+                }
+                column->ends.back() = i + 1;
+                column->nulls += std::holds_alternative<NaN>(values[i]);
+            }
+            column->runValues.shrink_to_fit();
+            column->ends.shrink_to_fit();
+            return column;
+        }
+
+        // Integers only, a nan-value repeats the previous integer so it costs no width
+        std::vector<int64_t> ints(values.size());
+        int64_t previous = 0;
+        for (size_t i = 0; i < values.size(); i++) {
+            if (std::holds_alternative<int>(values[i])) {
+                previous = std::get<int>(values[i]);
+            } else if (std::holds_alternative<NaN>(values[i])) {
+                if (column->nullBits.empty()) {
+                    column->nullBits.assign((values.size() + 63) / 64, 0);
+                }
+                column->nullBits[i >> 6] |= uint64_t(1) << (i & 63);
+                column->nulls++;
+            } else {
+                return nullptr;
+            }
+            ints[i] = previous;
+        }
+        if (encoding == Encoding::Delta) {
+            for (size_t i = values.size(); i-- > 0;) {
+                if (i % blockRows == 0) {
+                    column->blockBase.push_back(ints[i]);
+                    ints[i] = 0;
+                } else {
+                    ints[i] -= ints[i - 1];
+                }
+            }
+            std::reverse(column->blockBase.begin(), column->blockBase.end());
+        }
+        column->packed = PackedInts(ints);
+        return column;
+    }
+
+    /**
+     * @brief Returns whether two values are identical, used to delimit runs (nan-values equal each other)
+     */
+    static bool sameValue(const _cdfVal& lhs, const _cdfVal& rhs) {
+        if (lhs.index() != rhs.index()) {
+            return false;
+        }
+        if (std::holds_alternative<double>(lhs)) {
+            double a = std::get<double>(lhs), b = std::get<double>(rhs);
+            return a == b || (a != a && b != b);
+        }
+        return std::holds_alternative<NaN>(lhs) || lhs == rhs;
+    }
+
+    Encoding encoding() const { return kind; }
+    size_t size() const { return rows; }
+    size_t nullCount() const { return nulls; }
+
+    /**
+     * @brief Returns whether row i holds a nan-value, for the integer encodings.
+     */
+    bool isNull(size_t i) const { return !nullBits.empty() && (nullBits[i >> 6] >> (i & 63) & 1); }
+
+    /**
+     * @brief Calls `visit(row, value)` for the integers of rows [begin, end) of a frame-of-reference or delta
+     * column, nan-values included (they carry the previous integer, see `isNull`). `begin` must start a block for
+     * delta columns.
+     */
+    template <typename Visit>
+    void forEachInt(size_t begin, size_t end, const Visit& visit) const {
+        if (kind == Encoding::FrameOfReference) {
+            for (size_t i = begin; i < end; i++) {
+                visit(i, packed[i]);
+            }
+            return;
+        }
+        int64_t value = 0;
+        for (size_t i = begin; i < end; i++) {
+            value = i % blockRows == 0 ? blockBase[i / blockRows] : value + packed[i];
+            visit(i, value);
+        }
+    }
+
+    /**
+     * @brief Returns the runs of a run-length column, run r ends before row `runEnds()[r]`.
+     */
+    const std::vector<_cdfVal>& runs() const { return runValues; }
+    const std::vector<uint32_t>& runEnds() const { return ends; }
+
+    /**
+     * @brief Decodes the values.
+     */
+    std::vector<_cdfVal> decode() const {
+        std::vector<_cdfVal> values;
+        values.reserve(rows);
+        if (kind == Encoding::RunLength) {
+            for (size_t r = 0; r < runValues.size(); r++) {
+                values.resize(ends[r], runValues[r]);
+            }
+            return values;
+        }
+        forEachInt(0, rows, [&](size_t i, int64_t value) {
+            if (isNull(i)) {
+                values.emplace_back(NaN());
+            } else {
+                values.emplace_back(static_cast<int>(value));
+            }
+        });
+        return values;
+    }
+
+    /**
+     * @brief Decodes the values into a typed buffer, without going through variants.
+     *
+     * @throws std::runtime_error if string type field is found
+     */
+    kernels::TypedColumn toTyped() const {
+        kernels::TypedColumn column;
+        column.nullCount = nulls;
+        if (kind == Encoding::RunLength) {
+            kernels::TypedColumn typedRuns = kernels::toTypedColumn(runValues);
+            column.isInt = typedRuns.isInt;
+            column.validity.reserve(rows);
+            for (size_t r = 0; r < runValues.size(); r++) {
+                size_t end = ends[r];
+                column.validity.resize(end, typedRuns.validity[r]);
+                if (typedRuns.isInt) {
+                    column.ints.resize(end, typedRuns.ints[r]);
+                } else {
+                    column.doubles.resize(end, typedRuns.doubles[r]);
+                }
+            }
+            return column;
+        }
+        column.ints.resize(rows);
+        column.validity.resize(rows);
+        forEachInt(0, rows, [&](size_t i, int64_t value) {
+            bool valid = !isNull(i);
+            column.ints[i] = valid ? value : 0;
+            column.validity[i] = valid;
+        });
+        return column;
+    }
+
+    /**
+     * @brief Sums the numeric values, nan-values ignored, like `Series::sum`.
+     *
+     * @param result Receives the sum.
+     * @return false if the encoded form cannot answer exactly (runs of doubles), the values have to be decoded.
+     * @throws std::runtime_error if string type field is found
+     */
+    bool sum(double& result) const {
+        int64_t total = 0;
+        if (kind == Encoding::RunLength) {
+            for (size_t r = 0; r < runValues.size(); r++) {
+                const _cdfVal& value = runValues[r];
+                if (std::holds_alternative<std::string>(value)) {
+                    throw std::runtime_error("String Data-Type isn't expected!");
+                } else if (std::holds_alternative<double>(value)) {
+                    return false;
+                } else if (std::holds_alternative<int>(value)) {
+                    total += static_cast<int64_t>(std::get<int>(value)) * (ends[r] - (r ? ends[r - 1] : 0));
+                }
+            }
+        } else {
+            forEachInt(0, rows, [&](size_t i, int64_t value) { total += isNull(i) ? 0 : value; });
+        }
+        result = static_cast<double>(total);
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of non-nan values, like `Series::count`.
+     *
+     * @throws std::runtime_error if string type field is found
+     */
+    size_t count() const {
+        for (auto& value : runValues) {
+            if (std::holds_alternative<std::string>(value)) {
+                throw std::runtime_error("String Data-Type isn't expected!");
+            }
+        }
+        return rows - nulls;
+    }
+
+    /**
+     * @brief Returns the number of bytes held by the encoded values.
+     */
+    size_t memoryBytes() const {
+        return nullBits.capacity() * sizeof(uint64_t) + packed.memoryBytes() + blockBase.capacity() * sizeof(int64_t) +
+               variantBytes(runValues) + ends.capacity() * sizeof(uint32_t);
+    }
+};
+
+}  // namespace core
+
+}  // namespace cdf
+
+#endif
@@ -0,0 +1,349 @@
+#ifndef EXPR_HPP
+#define EXPR_HPP
+
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "data.hpp"
+#include "dtypes.hpp"
+#include "kernels.hpp"
+
+namespace cdf {
+
+/**
+ * @brief Column expressions built as compile-time expression trees.
+ *
+ * `cdf::col("a") > 3 && cdf::col("b") == "x"` does not compute anything, it builds a tree of typed nodes. Passing
+ * the tree to `DataFrame::operator[]` binds the column names once and evaluates the whole condition row by row in a
+ * single pass, `&&` and `||` stop as soon as the result is known. Comparisons follow the semantics of the
+ * `core::Series` comparison operators, arithmetic propagates nan-values.
+ */
+namespace expr {
+
+/**
+ * @brief Base of every expression node
+ */
+struct Node {};
+
+/**
+ * @brief Base of the nodes producing a value (`eval(row)`)
+ */
+struct ValueNode : Node {};
+
+/**
+ * @brief Base of the nodes producing a condition (`test(row)`)
+ */
+struct BoolNode : Node {};
+
+template <typename T>
+constexpr bool is_expr_v = std::is_base_of_v<Node, std::decay_t<T>>;
+
+template <typename T>
+constexpr bool is_value_expr_v = std::is_base_of_v<ValueNode, std::decay_t<T>>;
+
+template <typename T>
+constexpr bool is_bool_expr_v = std::is_base_of_v<BoolNode, std::decay_t<T>>;
+
+/**
+ * @brief Reference to a column by name, resolved to a position by `bind`
+ */
+class Column : public ValueNode {
+    std::string name;
+    int position = -1;
+
+   public:
+    explicit Column(std::string name) : name(name) {}
+
+    /**
+     * @brief Resolves the column name against the columns of a DataFrame
+     *
+     * @throws std::invalid_argument if the column is not present
+     */
+    void bind(const std::map<std::string, int>& columnIndexMap) {
+        auto it = columnIndexMap.find(name);
+        if (it == columnIndexMap.end()) {
+            throw std::invalid_argument("[cdf][DataFrame] Column " + name + " Not present");
+        }
+        position = it->second;
+    }
+
+    /**
+     * @brief Returns the position of the column, -1 before `bind`
+     */
+    int columnPosition() const { return position; }
+
+    template <typename RowT>
+    const _cdfVal& eval(const RowT& row) const {
+        return row[position];
+    }
+};
+
+/**
+ * @brief A constant, stored with its C++ type (int, double, std::string, or a variant for wide integers)
+ */
+template <typename T>
+class Literal : public ValueNode {
+    T value;
+
+   public:
+    explicit Literal(const T& value) : value(value) {}
+
+    void bind(const std::map<std::string, int>&) {}
+
+    template <typename RowT>
+    const T& eval(const RowT&) const {
+        return value;
+    }
+
+    const T& constant() const { return value; }
+};
+
+/**
+ * @brief Compares two variant values, the type held by rhs selects the comparison like for `core::Series`
+ */
+template <typename Comparator>
+bool compareOperands(const _cdfVal& lhs, const _cdfVal& rhs, const Comparator& op) {
+    return std::visit(
+        [&](const auto& v) -> bool {
+            if constexpr (std::is_same_v<std::decay_t<decltype(v)>, NaN>) {
+                return false;
+            } else {
+                return core::compareValue(lhs, v, op);
+            }
+        },
+        rhs);
+}
+
+template <typename T, typename Comparator>
+bool compareOperands(const _cdfVal& lhs, const T& rhs, const Comparator& op) {
+    return core::compareValue(lhs, rhs, op);
+}
+
+template <typename T, typename Comparator>
+bool compareOperands(const T& lhs, const _cdfVal& rhs, const Comparator& op) {
+    return compareOperands(_cdfVal(lhs), rhs, op);
+}
+
+/**
+ * @brief Comparison of two value nodes
+ */
+template <typename Comparator, typename L, typename R>
+class Compare : public BoolNode {
+    L lhs;
+    R rhs;
+
+   public:
+    Compare(const L& lhs, const R& rhs) : lhs(lhs), rhs(rhs) {}
+
+    void bind(const std::map<std::string, int>& columnIndexMap) {
+        lhs.bind(columnIndexMap);
+        rhs.bind(columnIndexMap);
+    }
+
+    template <typename RowT>
+    bool test(const RowT& row) const {
+        return compareOperands(lhs.eval(row), rhs.eval(row), Comparator{});
+    }
+
+    const L& left() const { return lhs; }
+    const R& right() const { return rhs; }
+};
+
+/**
+ * @brief Detects a comparison of a column with a constant (`col("a") > 3`), which column indexes can answer
+ */
+template <typename T>
+struct ColumnComparison : std::false_type {};
+
+template <typename Comparator, typename T>
+struct ColumnComparison<Compare<Comparator, Column, Literal<T>>> : std::true_type {
+    using comparator = Comparator;
+};
+
+/**
+ * @brief Conjunction of two conditions, rhs is only evaluated when lhs holds
+ */
+template <typename L, typename R>
+class And : public BoolNode {
+    L lhs;
+    R rhs;
+
+   public:
+    And(const L& lhs, const R& rhs) : lhs(lhs), rhs(rhs) {}
+
+    void bind(const std::map<std::string, int>& columnIndexMap) {
+        lhs.bind(columnIndexMap);
+        rhs.bind(columnIndexMap);
+    }
+
+    template <typename RowT>
+    bool test(const RowT& row) const {
+        return lhs.test(row) && rhs.test(row);
+    }
+};
+
+/**
+ * @brief Disjunction of two conditions, rhs is only evaluated when lhs does not hold
+ */
+template <typename L, typename R>
+class Or : public BoolNode {
+    L lhs;
+    R rhs;
+
+   public:
+    Or(const L& lhs, const R& rhs) : lhs(lhs), rhs(rhs) {}
+
+    void bind(const std::map<std::string, int>& columnIndexMap) {
+        lhs.bind(columnIndexMap);
+        rhs.bind(columnIndexMap);
+    }
+
+    template <typename RowT>
+    bool test(const RowT& row) const {
+        return lhs.test(row) || rhs.test(row);
+    }
+};
+
+/**
+ * @brief Negation of a condition
+ */
+template <typename E>
+class Not : public BoolNode {
+    E operand;
+
+   public:
+    explicit Not(const E& operand) : operand(operand) {}
+
+    void bind(const std::map<std::string, int>& columnIndexMap) { operand.bind(columnIndexMap); }
+
+    template <typename RowT>
+    bool test(const RowT& row) const {
+        return !operand.test(row);
+    }
+};
+
+/**
+ * @brief Arithmetic on two value nodes, see `kernels::applyArithmetic`
+ */
+template <typename Op, typename L, typename R>
+class Arithmetic : public ValueNode {
+    L lhs;
+    R rhs;
+
+   public:
+    Arithmetic(const L& lhs, const R& rhs) : lhs(lhs), rhs(rhs) {}
+
+    void bind(const std::map<std::string, int>& columnIndexMap) {
+        lhs.bind(columnIndexMap);
+        rhs.bind(columnIndexMap);
+    }
+
+    template <typename RowT>
+    _cdfVal eval(const RowT& row) const {
+        return kernels::applyArithmetic<Op>(_cdfVal(lhs.eval(row)), _cdfVal(rhs.eval(row)));
+    }
+};
+
+/**
+ * @brief Turns an operand into a value node, constants become literals of int, double or std::string
+ *
+ * Integer types wider than int become variant literals, holding a double when the value is outside of the int range.
+ */
+template <typename T>
+auto operand(const T& value) {
+    if constexpr (is_expr_v<T>) {
+        static_assert(is_value_expr_v<T>, "Conditions cannot be used as values");
+        return value;
+    } else if constexpr (std::is_integral_v<T> && (sizeof(T) < sizeof(int) || std::is_same_v<T, int>)) {
+        return Literal<int>(static_cast<int>(value));
+    } else if constexpr (std::is_integral_v<T>) {
+        return Literal<_cdfVal>(kernels::integerValue(value));
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return Literal<double>(static_cast<double>(value));
+    } else {
+        return Literal<std::string>(std::string(value));
+    }
+}
+
+template <typename T>
+using operand_t = decltype(operand(std::declval<T>()));
+
+template <typename L, typename R>
+using enable_if_operands = std::enable_if_t<is_expr_v<L> || is_expr_v<R>>;
+
+template <typename L, typename R>
+using enable_if_conditions = std::enable_if_t<is_bool_expr_v<L> && is_bool_expr_v<R>>;
+
+#define CDF_EXPR_COMPARISON(OPERATOR, COMPARATOR)                                                    \
+    template <typename L, typename R, typename = enable_if_operands<L, R>>                           \
+    Compare<COMPARATOR, operand_t<L>, operand_t<R>> operator OPERATOR(const L& lhs, const R& rhs) { \
+        return {operand(lhs), operand(rhs)};                                                         \
+    }
+
+CDF_EXPR_COMPARISON(==, std::equal_to<>)
+CDF_EXPR_COMPARISON(!=, std::not_equal_to<>)
+CDF_EXPR_COMPARISON(<, std::less<>)
+CDF_EXPR_COMPARISON(<=, std::less_equal<>)
+CDF_EXPR_COMPARISON(>, std::greater<>)
+CDF_EXPR_COMPARISON(>=, std::greater_equal<>)
+
+#undef CDF_EXPR_COMPARISON
+
+#define CDF_EXPR_ARITHMETIC(OPERATOR, OP)                                                               \
+    template <typename L, typename R, typename = enable_if_operands<L, R>>                              \
+    Arithmetic<OP, operand_t<L>, operand_t<R>> operator OPERATOR(const L& lhs, const R& rhs) {         \
+        return {operand(lhs), operand(rhs)};                                                            \
+    }
+
+CDF_EXPR_ARITHMETIC(+, std::plus<>)
+CDF_EXPR_ARITHMETIC(-, std::minus<>)
+CDF_EXPR_ARITHMETIC(*, std::multiplies<>)
+CDF_EXPR_ARITHMETIC(/, std::divides<>)
+
+#undef CDF_EXPR_ARITHMETIC
+
+template <typename L, typename R, typename = enable_if_conditions<L, R>>
+And<L, R> operator&&(const L& lhs, const R& rhs) {
+    return {lhs, rhs};
+}
+
+template <typename L, typename R, typename = enable_if_conditions<L, R>>
+And<L, R> operator&(const L& lhs, const R& rhs) {
+    return {lhs, rhs};
+}
+
+template <typename L, typename R, typename = enable_if_conditions<L, R>>
+Or<L, R> operator||(const L& lhs, const R& rhs) {
+    return {lhs, rhs};
+}
+
+template <typename L, typename R, typename = enable_if_conditions<L, R>>
+Or<L, R> operator|(const L& lhs, const R& rhs) {
+    return {lhs, rhs};
+}
+
+template <typename E, typename = std::enable_if_t<is_bool_expr_v<E>>>
+Not<E> operator!(const E& operand) {
+    return Not<E>(operand);
+}
+
+}  // namespace expr
+
+/**
+ * @brief Refers to a column inside a column expression.
+ *
+ * Example:
+ * ```
+ * df = df[cdf::col("Age") > 30 && cdf::col("Department") == "Sales"];
+ * ```
+ *
+ * @param name The name of the column.
+ */
+expr::Column col(const std::string& name) { return expr::Column(name); }
+
+}  // namespace cdf
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef HASHTABLE_HPP
+#define HASHTABLE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "dtypes.hpp"
+#include "utils.hpp"
+
+namespace cdf {
+
+namespace core {
+
+/**
+ * @brief Hash functor for 64-bit integer keys
+ */
+struct IntegerHash {
+    uint64_t operator()(int64_t key) const { return mixHash(static_cast<uint64_t>(key)); }
+};
+
+/**
+ * @brief Hash functor for double keys, `0.0` and `-0.0` share a hash
+ */
+struct DoubleHash {
+    uint64_t operator()(double key) const { return hashDouble(key); }
+};
+
+/**
+ * @brief Hash functor for string keys
+ */
+struct StringViewHash {
+    uint64_t operator()(std::string_view key) const { return hashBytes(key.data(), key.size()); }
+};
+
+/**
+ * @brief Hash functor for keys pointing to variant values, `1` and `1.0` share a hash
+ */
+struct VariantPtrHash {
+    uint64_t operator()(const _cdfVal* key) const { return hashValue(*key); }
+};
+
+/**
+ * @brief Equality functor for keys pointing to variant values
+ */
+struct VariantPtrEqual {
+    bool operator()(const _cdfVal* lhs, const _cdfVal* rhs) const { return valueEquals(*lhs, *rhs); }
+};
+
+/**
+ * @class OpenHashMap
+ * @brief A flat hash map with open addressing and linear probing.
+ *
+ * Entries are stored densely in insertion order, next to their cached hash. The probe table only holds 32-bit entry
+ * indices, so a probe touches one small array and compares full keys only when the cached hashes match. The table is
+ * kept at most half full and grows by doubling. Entries cannot be erased.
+ *
+ * @tparam Key The key type.
+ * @tparam Value The mapped type.
+ * @tparam Hash Functor returning a 64-bit hash of a key.
+ * @tparam Equal Functor comparing two keys.
+ */
+template <typename Key, typename Value, typename Hash, typename Equal = std::equal_to<Key>>
+class OpenHashMap {
+    static constexpr uint32_t emptySlot = std::numeric_limits<uint32_t>::max();
+
+    std::vector<Key> keys;
+    std::vector<Value> values;
+    std::vector<uint64_t> hashes;
+    std::vector<uint32_t> slots;
+    size_t mask;
+    Hash hasher;
+    Equal equal;
+
+    void rehash(size_t numSlots) {
+        slots.assign(numSlots, emptySlot);
+        mask = numSlots - 1;
+        for (size_t entry = 0; entry < hashes.size(); entry++) {
+            size_t slot = hashes[entry] & mask;
+            while (slots[slot] != emptySlot) {
+                slot = (slot + 1) & mask;
+            }
+            slots[slot] = entry;
+        }
+    }
+
+   public:
+    /**
+     * @brief Constructs an empty map.
+     *
+     * @param expectedSize Number of entries to make room for without growing (default is 8).
+     * @param hasher The hash functor, for functors carrying state.
+     * @param equal The equality functor, for functors carrying state.
+     */
+    OpenHashMap(size_t expectedSize = 8, Hash hasher = Hash(), Equal equal = Equal())
+        : hasher(hasher), equal(equal) {
+        reserve(expectedSize);
+        if (slots.empty()) {
+            rehash(16);
+        }
+    }
+
+    /**
+     * @brief Makes room for the given number of entries.
+     */
+    void reserve(size_t expectedSize) {
+        size_t numSlots = 16;
+        while (numSlots < expectedSize * 2) {
+            numSlots <<= 1;
+        }
+        if (numSlots > slots.size()) {
+            keys.reserve(expectedSize);
+            values.reserve(expectedSize);
+            hashes.reserve(expectedSize);
+            rehash(numSlots);
+        }
+    }
+
+    /**
+     * @brief Returns the number of entries.
+     */
+    size_t size() const { return keys.size(); }
+
+    /**
+     * @brief Inserts a key if it is not present yet.
+     *
+     * @param key The key to look up.
+     * @param initial The value stored when the key is inserted.
+     * @return The index of the key's entry and whether it was inserted.
+     */
+    std::pair<size_t, bool> insert(const Key& key, const Value& initial = Value()) {
+        uint64_t hash = hasher(key);
+        size_t slot = hash & mask;
+        while (slots[slot] != emptySlot) {
+            uint32_t entry = slots[slot];
+            if (hashes[entry] == hash && equal(keys[entry], key)) {
+                return {entry, false};
+            }
+            slot = (slot + 1) & mask;
+        }
+
+        size_t entry = keys.size();
+        keys.push_back(key);
+        values.push_back(initial);
+        hashes.push_back(hash);
+        slots[slot] = entry;
+        if (keys.size() * 2 > slots.size()) {
+            rehash(slots.size() * 2);
+        }
+        return {entry, true};
+    }
+
+    /**
+     * @brief Finds the entry of a key.
+     *
+     * @return The entry index, or -1 if the key is not present.
+     */
+    long long find(const Key& key) const {
+        uint64_t hash = hasher(key);
+        size_t slot = hash & mask;
+        while (slots[slot] != emptySlot) {
+            uint32_t entry = slots[slot];
+            if (hashes[entry] == hash && equal(keys[entry], key)) {
+                return entry;
+            }
+            slot = (slot + 1) & mask;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Accesses the key of an entry.
+     */
+    const Key& key(size_t entry) const { return keys[entry]; }
+
+    /**
+     * @brief Accesses the value of an entry.
+     */
+    Value& value(size_t entry) { return values[entry]; }
+    const Value& value(size_t entry) const { return values[entry]; }
+
+    /**
+     * @brief Returns the values of all the entries in insertion order.
+     */
+    const std::vector<Value>& allValues() const { return values; }
+};
+
+}  // namespace core
+
+}  // namespace cdf
+
+#endif
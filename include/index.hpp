@@ -0,0 +1,214 @@
+#ifndef INDEX_HPP
+#define INDEX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "dtypes.hpp"
+#include "hashtable.hpp"
+#include "utils.hpp"
+
+namespace cdf {
+
+/**
+ * @brief Kind of a secondary index over a column.
+ */
+enum class IndexKind {
+    Hash,  /**< Groups the rows by value, answers equality lookups in O(1) */
+    Sorted /**< Permutation of the rows ordered by value, answers equality and range lookups in O(log n) */
+};
+
+namespace core {
+
+/**
+ * @class ColumnIndex
+ * @brief A secondary index over the values of a column.
+ *
+ * The index keeps row positions only, keys are read from the indexed values, which must outlive it and stay
+ * unchanged. Nan-values are not indexed, they never match a comparison. Lookups answer with the matching rows in
+ * ascending order and follow the semantics of the `Series` comparison operators: a numeric column is searched with
+ * numbers, a string column with strings. Other lookups are reported as unsupported so the caller scans instead.
+ */
+class ColumnIndex {
+    IndexKind kind;
+    bool numeric = true;
+
+    // Hash index: rows of group g are rows[offsets[g], offsets[g + 1])
+    OpenHashMap<const _cdfVal*, uint32_t, VariantPtrHash, VariantPtrEqual> groups;
+    std::vector<uint32_t> offsets;
+    std::vector<int> rows;
+
+    // Sorted index: indexed rows ordered by value, ties in row order
+    std::vector<int> order;
+
+    static bool isIndexed(const _cdfVal& value) { return !isMissing(value); }
+
+   public:
+    /**
+     * @brief Builds an index over the given values.
+     *
+     * @throws std::invalid_argument if the values mix strings and numbers
+     */
+    ColumnIndex(const std::vector<_cdfVal>& values, IndexKind kind) : kind(kind) {
+        bool hasStrings = false, hasNumbers = false;
+        for (auto& value : values) {
+            hasStrings = hasStrings || std::holds_alternative<std::string>(value);
+            hasNumbers = hasNumbers || std::holds_alternative<int>(value) || std::holds_alternative<double>(value);
+        }
+        if (hasStrings && hasNumbers) {
+            throw std::invalid_argument("[cdf][Index] Columns mixing strings and numbers cannot be indexed");
+        }
+        numeric = !hasStrings;
+
+        if (kind == IndexKind::Sorted) {
+            for (size_t i = 0; i < values.size(); i++) {
+                if (isIndexed(values[i])) {
+                    order.push_back(i);
+                }
+            }
+            std::stable_sort(order.begin(), order.end(),
+                             [&values](int lhs, int rhs) { return valueLess(values[lhs], values[rhs]); });
+            return;
+        }
+
+        // Two passes: number the groups and count their rows, then lay the rows out group by group
+        std::vector<uint32_t> groupOf(values.size());
+        std::vector<uint32_t> counts;
+        for (size_t i = 0; i < values.size(); i++) {
+            if (!isIndexed(values[i])) {
+                continue;
+            }
+            auto [entry, inserted] = groups.insert(&values[i], counts.size());
+            if (inserted) {
+                counts.push_back(0);
+            }
+            groupOf[i] = groups.value(entry);
+            counts[groupOf[i]]++;
+        }
+
+        offsets.assign(counts.size() + 1, 0);
+        for (size_t g = 0; g < counts.size(); g++) {
+            offsets[g + 1] = offsets[g] + counts[g];
+        }
+        rows.resize(offsets.back());
+        std::vector<uint32_t> next(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < values.size(); i++) {
+            if (isIndexed(values[i])) {
+                rows[next[groupOf[i]]++] = i;
+            }
+        }
+    }
+
+    IndexKind indexKind() const { return kind; }
+
+    /**
+     * @brief Looks up the rows whose value compares true with a probe.
+     *
+     * @param values The indexed values.
+     * @param probe The value compared against, an int, a double or a string.
+     * @param op One of the `std::equal_to<>`, `std::less<>`, `std::less_equal<>`, `std::greater<>` or
+     * `std::greater_equal<>` comparators.
+     * @param result Receives the matching rows in ascending order.
+     * @return false if the index cannot answer the lookup (comparator, index kind or probe type).
+     */
+    template <typename Comparator>
+    bool lookup(const std::vector<_cdfVal>& values, const _cdfVal& probe, const Comparator&,
+                std::vector<int>& result) const {
+        constexpr bool isEqual = std::is_same_v<Comparator, std::equal_to<>>;
+        constexpr bool isRange = std::is_same_v<Comparator, std::less<>> ||
+                                 std::is_same_v<Comparator, std::less_equal<>> ||
+                                 std::is_same_v<Comparator, std::greater<>> ||
+                                 std::is_same_v<Comparator, std::greater_equal<>>;
+        bool probeNumeric = std::holds_alternative<int>(probe) || std::holds_alternative<double>(probe);
+        bool probeString = std::holds_alternative<std::string>(probe);
+        if (!(isEqual || isRange) || (numeric ? !probeNumeric : !probeString)) {
+            return false;
+        }
+
+        result.clear();
+        if (!isIndexed(probe)) {
+            return true;
+        }
+
+        if (kind == IndexKind::Hash) {
+            if (!isEqual) {
+                return false;
+            }
+            long long entry = groups.find(&probe);
+            if (entry >= 0) {
+                uint32_t group = groups.value(entry);
+                result.assign(rows.begin() + offsets[group], rows.begin() + offsets[group + 1]);
+            }
+            return true;
+        }
+
+        auto below = [&values](int row, const _cdfVal& value) { return valueLess(values[row], value); };
+        auto above = [&values](const _cdfVal& value, int row) { return valueLess(value, values[row]); };
+        auto lower = std::lower_bound(order.begin(), order.end(), probe, below);
+        auto upper = std::upper_bound(lower, order.end(), probe, above);
+        if constexpr (isEqual) {
+            result.assign(lower, upper);
+            return true;
+        } else if constexpr (std::is_same_v<Comparator, std::less<>>) {
+            result.assign(order.begin(), lower);
+        } else if constexpr (std::is_same_v<Comparator, std::less_equal<>>) {
+            result.assign(order.begin(), upper);
+        } else if constexpr (std::is_same_v<Comparator, std::greater<>>) {
+            result.assign(upper, order.end());
+        } else {
+            result.assign(lower, order.end());
+        }
+        std::sort(result.begin(), result.end());
+        return true;
+    }
+
+    /**
+     * @brief Looks up the rows whose value lies in [low, high], with a sorted index.
+     *
+     * @return false if the index cannot answer the lookup.
+     */
+    bool lookupBetween(const std::vector<_cdfVal>& values, const _cdfVal& low, const _cdfVal& high,
+                       std::vector<int>& result) const {
+        bool lowNumeric = std::holds_alternative<int>(low) || std::holds_alternative<double>(low);
+        bool highNumeric = std::holds_alternative<int>(high) || std::holds_alternative<double>(high);
+        bool lowString = std::holds_alternative<std::string>(low);
+        bool highString = std::holds_alternative<std::string>(high);
+        bool supported = numeric ? lowNumeric && highNumeric : lowString && highString;
+        if (kind != IndexKind::Sorted || !supported) {
+            return false;
+        }
+
+        result.clear();
+        if (!isIndexed(low) || !isIndexed(high) || valueLess(high, low)) {
+            return true;
+        }
+        auto below = [&values](int row, const _cdfVal& value) { return valueLess(values[row], value); };
+        auto above = [&values](const _cdfVal& value, int row) { return valueLess(value, values[row]); };
+        auto lower = std::lower_bound(order.begin(), order.end(), low, below);
+        auto upper = std::upper_bound(lower, order.end(), high, above);
+        result.assign(lower, upper);
+        std::sort(result.begin(), result.end());
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of bytes held by the index.
+     */
+    size_t memoryBytes() const {
+        return groups.size() * (sizeof(const _cdfVal*) + sizeof(uint32_t) + sizeof(uint64_t) + 2 * sizeof(uint32_t)) +
+               offsets.capacity() * sizeof(uint32_t) + rows.capacity() * sizeof(int) +
+               order.capacity() * sizeof(int);
+    }
+};
+
+}  // namespace core
+
+}  // namespace cdf
+
+#endif
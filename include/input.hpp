@@ -1,14 +1,24 @@
 #ifndef INPUT_HPP
 #define INPUT_HPP
 
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <iterator>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 
+#include "compression.hpp"
 #include "data.hpp"
 #include "dataframe.hpp"
 #include "dtypes.hpp"
+#include "parallel.hpp"
+#include "trace.hpp"
 #include "utils.hpp"
 
 namespace cdf {
@@ -23,7 +33,7 @@ namespace io {
  * @returns Number of columns of the CSV File
  */
 int countFieldsCSV(std::string& csvFilePath, char delimiter = ',') {
-    std::ifstream file(csvFilePath);
+    InputFile file(csvFilePath);
     if (!file.is_open()) {
         std::cerr << "Unable to read " << csvFilePath << " !" << std::endl;
         return -1;
@@ -51,6 +61,110 @@ int countFieldsCSV(std::string& csvFilePath, char delimiter = ',') {
     return 0;  // Return 0 if file is empty
 }
 
+/**
+ * @brief Splits a CSV line into its fields
+ *
+ * Whenever a field value contains the delimiter, the field is enclosed with "". The pieces of such a field are joined
+ * back together, an unterminated quote carries over to the next line through `inQuotes` and `quotedString`.
+ *
+ * @param line The line to split
+ * @param delimiter Delimiter of the CSV File
+ * @param fields Receives the fields of the line
+ * @param inQuotes Quote state shared between consecutive lines
+ * @param quotedString Pieces of the quoted field read so far
+ */
+void splitCSVLine(const std::string& line, char delimiter, std::vector<std::string>& fields, bool& inQuotes,
+                  std::string& quotedString) {
+    fields.clear();
+    std::string val;
+    std::stringstream valueStream(line);
+
+    while (std::getline(valueStream, val, delimiter)) {
+        // Whenever a quoted character is found, we concatenate the pieces until end quote comes
+        if (val[0] == '"' && val[val.size() - 1] != '"') {
+            inQuotes = true;
+            quotedString += val.substr(1);
+        } else if (inQuotes) {
+            quotedString += "," + val;
+            if (val[val.size() - 1] == '"') {
+                inQuotes = false;
+                val = quotedString.substr(0, quotedString.size() - 1);
+                quotedString = "";
+            }
+        }
+        if (!inQuotes) {
+            fields.push_back(val);
+        }
+    }
+    if (!line.empty() && line[line.size() - 1] == ',') {
+        fields.push_back("");
+    }
+}
+
+/**
+ * @brief Widens the inferred type of every field of a row to the type of its value
+ *
+ * Priority of the data-types -> string > double > int, blank fields keep the type.
+ *
+ * @param fields The fields of the row
+ * @param fieldTypes Rank of the type of every column, see `dTypeWithRank`
+ */
+void inferFieldTypes(const std::vector<std::string>& fields, std::vector<int>& fieldTypes) {
+    for (size_t j = 0; j < fields.size() && j < fieldTypes.size(); j++) {
+        if (fields[j] != "") {
+            std::pair<int, _cdfVal> inferredData = inferAndConvert(fields[j]);
+            if (fieldTypes[j] < inferredData.first) {
+                fieldTypes[j] = inferredData.first;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Converts the cached fields of rows to the inferred types of their columns
+ *
+ * Blank fields, and the fields missing from short rows, become nan-values. Strings are moved out of the cache. Every
+ * morsel of every column is converted by a task of its own.
+ *
+ * @param cache The fields of every row
+ * @param fieldTypes Rank of the type of every column, see `dTypeWithRank`
+ * @returns The rows, one column per field type
+ */
+core::Data convertFields(std::vector<std::vector<std::string>>& cache, const std::vector<int>& fieldTypes) {
+    size_t numColumns = fieldTypes.size();
+    size_t numMorsels = parallel::morselCount(cache.size());
+    size_t morselSize = parallel::settings().morselSize;
+    std::vector<std::vector<_cdfVal>> columns(numColumns, std::vector<_cdfVal>(cache.size()));
+
+    parallel::runTasks(numColumns * numMorsels, [&](size_t task) {
+        size_t j = task % numColumns;
+        size_t begin = task / numColumns * morselSize;
+        size_t end = std::min(cache.size(), begin + morselSize);
+        std::vector<_cdfVal>& column = columns[j];
+        for (size_t i = begin; i < end; i++) {
+            if (j >= cache[i].size() || cache[i][j] == "") {
+                // Pushing nan in place of blank string
+                column[i] = NaN();
+            } else if (fieldTypes[j] == 0) {
+                // Integer Conversion
+                column[i] = std::stoi(cache[i][j]);
+            } else if (fieldTypes[j] == 1) {
+                // Double Conversion
+                column[i] = std::stod(cache[i][j]);
+            } else if (fieldTypes[j] == 2) {
+                // String, No Conversion
+                column[i] = std::move(cache[i][j]);
+            }
+        }
+    });
+
+    core::Data data;
+    for (auto& column : columns) {
+        data.addColumn(std::move(column));
+    }
+    return data;
+}
+
 /**
  * @brief Reads a CSV file and loads data into a cdf::DataFrame. (Old Implementation)
  *
@@ -139,12 +253,167 @@ DataFrame read_csv_old(std::string csvFilePath, char delimiter = ',', int header
     return df;
 }
 
+/**
+ * @class BlockReader
+ * @brief Reads a file in large blocks on a background thread, ahead of the consumer.
+ *
+ * The I/O thread fills a ring of buffers and waits when every buffer holds a block not consumed yet, so reading runs
+ * while the previous blocks are parsed and memory stays bounded by the ring. A compressed file is decompressed by the
+ * I/O thread as it is read, see `InputFile`.
+ */
+class BlockReader {
+    InputFile file;
+    size_t blockBytes;
+    std::vector<std::string> ring;
+    size_t head = 0;    /**< Next block handed to the consumer */
+    size_t filled = 0;  /**< Blocks read and not consumed yet */
+    bool finished = false;
+    bool stopping = false;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::thread io;
+
+    void readLoop() {
+        try {
+            while (true) {
+                size_t slot;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [this] { return stopping || filled < ring.size(); });
+                    if (stopping) {
+                        return;
+                    }
+                    slot = (head + filled) % ring.size();
+                }
+                // The free slot is not touched by the consumer, it is filled without the lock
+                std::string& block = ring[slot];
+                block.resize(blockBytes);
+                file.read(&block[0], blockBytes);
+                block.resize(file.gcount());
+                std::lock_guard<std::mutex> lock(mutex);
+                if (block.empty()) {
+                    finished = true;
+                    changed.notify_all();
+                    return;
+                }
+                filled++;
+                changed.notify_all();
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+            finished = true;
+            changed.notify_all();
+        }
+    }
+
+   public:
+    /**
+     * @brief Opens a file and starts reading it.
+     *
+     * @param path The path to the file.
+     * @param blockBytes Bytes per block (default is `set_read_block_size`).
+     * @param ringSize Number of blocks read ahead (default is one per thread, and two more).
+     */
+    explicit BlockReader(const std::string& path, size_t blockBytes = parallel::settings().readBlockSize,
+                         size_t ringSize = parallel::settings().numThreads + 2)
+        : file(path, std::ios::binary),
+          blockBytes(std::max<size_t>(blockBytes, 1)),
+          ring(std::max<size_t>(ringSize, 2)) {
+        if (file.is_open()) {
+            io = std::thread(&BlockReader::readLoop, this);
+        }
+    }
+
+    BlockReader(const BlockReader&) = delete;
+    BlockReader& operator=(const BlockReader&) = delete;
+
+    /**
+     * @brief Stops reading and joins the I/O thread.
+     */
+    ~BlockReader() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        if (io.joinable()) {
+            io.join();
+        }
+    }
+
+    bool is_open() const { return file.is_open(); }
+
+    /**
+     * @brief Waits for the next block and swaps it into `block`, whose buffer goes back to the ring.
+     *
+     * @return false once the whole file was handed out.
+     * @throws The exception raised by the I/O thread, if any.
+     */
+    bool next(std::string& block) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return filled > 0 || finished; });
+        if (filled == 0) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            return false;
+        }
+        block.swap(ring[head]);
+        head = (head + 1) % ring.size();
+        filled--;
+        changed.notify_all();
+        return true;
+    }
+};
+
+/**
+ * @brief Lines of a CSV file split into fields, with the types they hold.
+ */
+struct ParsedBlock {
+    std::string text; /**< Complete lines without their last line break, released once parsed */
+    std::vector<std::vector<std::string>> rows;
+    std::vector<int> fieldTypes;
+    bool inQuotes = false;    /**< Quote state after the last line */
+    std::string quotedString; /**< Pieces of the quoted field open after the last line */
+
+    /**
+     * @brief Splits every line of the text, starting from the given quote state.
+     */
+    void parse(char delimiter, size_t numColumns, bool startInQuotes = false, std::string startQuoted = "") {
+        rows.clear();
+        fieldTypes.assign(numColumns, 0);
+        inQuotes = startInQuotes;
+        quotedString = std::move(startQuoted);
+        std::string line;
+        for (size_t begin = 0; begin <= text.size();) {
+            size_t end = std::min(text.find('\n', begin), text.size());
+            line.assign(text, begin, end - begin);
+            std::vector<std::string> rowVector;
+            splitCSVLine(line, delimiter, rowVector, inQuotes, quotedString);
+            inferFieldTypes(rowVector, fieldTypes);
+            rows.push_back(std::move(rowVector));
+            begin = end + 1;
+        }
+    }
+
+    bool endsInQuotes() const { return inQuotes || !quotedString.empty(); }
+};
+
 /**
  * @brief Reads a CSV file and loads data into a cdf::DataFrame.
  *
  * This function opens a CSV file, processes its content, and converts it into a `DataFrame` object.
  * It handles headers, row parsing, and converts data types as necessary based on the file contents.
  *
+ * Reading and parsing overlap: a `BlockReader` thread reads blocks ahead (see `set_read_block_size`) while the blocks
+ * already read, cut at line boundaries, are split and typed in parallel, one task per block. The values are then
+ * converted column by column in parallel. The result is the same as a line by line read.
+ *
+ * Gzip and zstd files are detected from their first bytes and decompressed by the I/O thread as the blocks are read,
+ * so decompression overlaps parsing and the decompressed file is never held whole, see `InputFile`.
+ *
  * @param csvFilePath The path to the CSV file to be loaded.
  * @param delimiter The delimiter used to separate columns (default is comma `,`).
  * @param header The line number that contains the column headers. If `header` is -1, no headers are read from the file.
@@ -152,12 +421,11 @@ DataFrame read_csv_old(std::string csvFilePath, char delimiter = ',', int header
  * headers.
  * @return A `DataFrame` object containing the data read from the CSV file.
  * @throws std::ios_base::failure if the file cannot be opened.
+ * @throws std::runtime_error if the file is compressed in a format this build does not read, or is corrupted.
  */
 DataFrame read_csv(std::string csvFilePath, char delimiter = ',', int header = 0, std::vector<std::string> names = {}) {
+    CDF_TRACE_SPAN(span, "io::read_csv");
     int numColumns;
-    NaN nan = NaN();
-    // Store a cache loading the field values before going for type-conversion
-    std::vector<std::vector<std::string>> cache;
 
     std::vector<std::string> headers;
     if (names.size() > 0) {
@@ -168,108 +436,305 @@ DataFrame read_csv(std::string csvFilePath, char delimiter = ',', int header = 0
         // Data-Type Definitions
         numColumns = countFieldsCSV(csvFilePath, delimiter);
     }
-    std::vector<int> fieldTypes(numColumns, 0);
 
-    // Open the filepath
-    std::ifstream csvFile(csvFilePath);
+    // Open the filepath, the blocks are read ahead from now on
+    BlockReader reader(csvFilePath);
 
     // Check if the file can be opened
-    if (!csvFile.is_open()) {
+    if (!reader.is_open()) {
         std::cerr << "Unable to load " << csvFilePath << " !" << std::endl;
         return DataFrame();
     }
-
-    std::string line;
-    int currIdx = 0;
-    bool inQuotes = false;
-    std::string quotedString = "";
-
-    // Data Type Vectors to find actual data-type of the columns
-    // std::vector<std::string> dTypeRank[3] =
-
-    // Parsing through CSV File and storing values as string in a cache
-    while (std::getline(csvFile, line)) {
-        std::string val;
-        std::stringstream valueStream(line);
-
-        if (currIdx == header) {
-            while (std::getline(valueStream, val, delimiter)) {
-                headers.push_back(val);
+    numColumns = std::max(numColumns, 0);
+
+    CDF_TRACE_PHASE(parse, "io::read_csv/parse_and_infer");
+    std::vector<ParsedBlock> blocks;
+    size_t parsedBlocks = 0;
+    auto parsePending = [&] {
+        parallel::runTasks(blocks.size() - parsedBlocks,
+                           [&](size_t k) { blocks[parsedBlocks + k].parse(delimiter, numColumns); });
+        for (size_t b = parsedBlocks; b < blocks.size(); b++) {
+            // A quoted field left open by the previous block continues in this one, which is split again
+            if (b > 0 && blocks[b - 1].endsInQuotes()) {
+                blocks[b].parse(delimiter, numColumns, blocks[b - 1].inQuotes, blocks[b - 1].quotedString);
             }
-        } else if (currIdx >= 0) {
-            std::vector<std::string> rowVector;
+            std::string().swap(blocks[b].text);
+        }
+        parsedBlocks = blocks.size();
+    };
 
-            // Parse through Row Values
-            while (std::getline(valueStream, val, delimiter)) {
-                // Handling added whenever any value of the CSV file carries ',' character
-                // Whenever a field value contains ',', the field is contained with ""
-                // So, whenever a quted character is found, we concatenate the responses from the
-                // string split responses until end quote comes
-                if (val[0] == '"' && val[val.size() - 1] != '"') {
-                    inQuotes = true;
-                    quotedString += val.substr(1);
-                } else if (inQuotes) {
-                    quotedString += "," + val;
-                    if (val[val.size() - 1] == '"') {
-                        inQuotes = false;
-                        val = quotedString.substr(0, quotedString.size() - 1);
-                        quotedString = "";
-                    }
-                }
-                if (!inQuotes) {
-                    rowVector.push_back(val);
-
-                    if (val != "") {
-                        // Updating Data Type if current data type doesn't matches with returned response
-                        // Priority of the data-types -> string > double > int
-                        std::pair<int, _cdfVal> inferredData = inferAndConvert(val);
-                        if (fieldTypes[rowVector.size() - 1] < inferredData.first) {
-                            fieldTypes[rowVector.size() - 1] = inferredData.first;
-                        }
-                    }
+    // Lines before the header are data, the header line is split on the calling thread
+    int currIdx = 0;
+    std::string carry, block;
+    auto takeLines = [&](std::string text) {
+        size_t begin = 0;
+        while (currIdx <= header) {
+            size_t end = std::min(text.find('\n', begin), text.size());
+            if (currIdx == header) {
+                std::string val;
+                std::stringstream valueStream(text.substr(begin, end - begin));
+                while (std::getline(valueStream, val, delimiter)) {
+                    headers.push_back(val);
                 }
+            } else {
+                blocks.emplace_back();
+                blocks.back().text = text.substr(begin, end - begin);
             }
-            if (line[line.size() - 1] == ',') {
-                val = "";
-                rowVector.push_back(val);
+            ++currIdx;
+            begin = end + 1;
+            if (begin > text.size()) {
+                return;
             }
-            cache.push_back(rowVector);
         }
-        ++currIdx;
+        blocks.emplace_back();
+        blocks.back().text = begin == 0 ? std::move(text) : text.substr(begin);
+    };
+    while (reader.next(block)) {
+        size_t cut = block.rfind('\n');
+        if (cut == std::string::npos) {
+            carry += block;
+            continue;
+        }
+        std::string text = std::move(carry);
+        text.append(block, 0, cut);
+        carry.assign(block, cut + 1, std::string::npos);
+        takeLines(std::move(text));
+        if (blocks.size() - parsedBlocks >= parallel::settings().numThreads) {
+            parsePending();
+        }
+    }
+    if (!carry.empty()) {
+        takeLines(std::move(carry));
     }
+    parsePending();
 
-    // // Print data-type for each fields
-    // for (int i = 0; i < headers.size(); i++) {
-    //     std::cout << fieldTypes[i] << " " << headers[i] << " : " << dTypeWithRank[fieldTypes[i]] << "\n";
-    // }
+    std::vector<int> fieldTypes(numColumns, 0);
+    size_t numRows = 0;
+    for (auto& parsed : blocks) {
+        for (size_t j = 0; j < fieldTypes.size(); j++) {
+            fieldTypes[j] = std::max(fieldTypes[j], parsed.fieldTypes[j]);
+        }
+        numRows += parsed.rows.size();
+    }
+    std::vector<std::vector<std::string>> cache;
+    cache.reserve(numRows);
+    for (auto& parsed : blocks) {
+        std::move(parsed.rows.begin(), parsed.rows.end(), std::back_inserter(cache));
+    }
+    blocks.clear();
+    parse.rowsOut(cache.size());
+    parse.end();
 
     // Insert data into Data class after updating data-type
-    core::Data data(headers.size());
+    CDF_TRACE_PHASE(convert, "io::read_csv/convert");
+    convert.rowsIn(cache.size());
+    convert.rowsOut(cache.size());
+    fieldTypes.resize(headers.size(), 0);
+    core::Data data = convertFields(cache, fieldTypes);
 
-    for (int i = 0; i < cache.size(); i++) {
-        std::vector<_cdfVal> cacheRow;
-        for (int j = 0; j < headers.size(); j++) {
-            if (cache[i][j] == "") {
-                // Pushing nan in place of blank string
-                cacheRow.push_back(nan);
-            } else if (fieldTypes[j] == 0) {
-                // Integer Conversion
-                cacheRow.push_back(std::stoi(cache[i][j]));
-            } else if (fieldTypes[j] == 1) {
-                // Double Conversion
-                cacheRow.push_back(std::stod(cache[i][j]));
-            } else if (fieldTypes[j] == 2) {
-                // String, No Conversion
-                cacheRow.push_back(cache[i][j]);
-            }
+    // Load Data into a dataframe
+    convert.end();
+    DataFrame df = DataFrame(std::move(data), headers);
+    span.rowsOut(df.shape().first);
+
+    return df;
+};
+
+/**
+ * @brief Reads a CSV file on a thread of its own, see `read_csv` for the parameters.
+ *
+ * Several files can be loaded at once, while the caller does other work:
+ * ```
+ * auto orders = cdf::io::read_csv_async("orders.csv");
+ * auto users = cdf::io::read_csv_async("users.csv");
+ * cdf::DataFrame joined = merge(orders.get(), users.get());
+ * ```
+ *
+ * @return A future holding the DataFrame, or the exception raised while reading.
+ */
+std::future<DataFrame> read_csv_async(std::string csvFilePath, char delimiter = ',', int header = 0,
+                                      std::vector<std::string> names = {}) {
+    return std::async(std::launch::async, [=] { return read_csv(csvFilePath, delimiter, header, names); });
+}
+
+/**
+ * @class CsvFollower
+ * @brief Follows a CSV file which is being appended to, each `poll()` parses only the lines added since the last one.
+ *
+ * The follower remembers the byte offset reached and the column types inferred so far. A poll reads from that offset
+ * to the last complete line, a partially written last line waits for the next poll. The types are kept across polls:
+ * a value which does not fit the type of its column (a double in an integer column) widens the column type for the
+ * new rows, rows read earlier keep their values.
+ *
+ * The file is considered rotated, and read again from its start, header included, when it becomes shorter than the
+ * offset reached or its first bytes change. Lines added to the previous file after the last poll are not read.
+ *
+ * Example:
+ * ```
+ * cdf::io::CsvFollower follower("/var/log/requests.csv");
+ * cdf::DataFrame requests;
+ * while (true) {
+ *     follower.poll(requests);
+ *     std::this_thread::sleep_for(std::chrono::seconds(1));
+ * }
+ * ```
+ */
+class CsvFollower {
+    static constexpr size_t signatureBytes = 256; /**< First bytes of the file compared to detect a rotation */
+
+    std::string csvFilePath;
+    char delimiter;
+    int header;
+    std::vector<std::string> headers;
+    std::vector<int> fieldTypes; /**< Rank of the type of every column, see `dTypeWithRank` */
+    std::streamoff offset = 0;   /**< Start of the first line not read yet */
+    int lineIdx = 0;             /**< Index of the next line in the file */
+    std::string signature;       /**< First bytes of the file read so far */
+
+    bool rotated(std::ifstream& file, std::streamoff size) {
+        if (size < offset) {
+            return true;
         }
-        data.push_back(cacheRow);
+        std::string head(signature.size(), '\0');
+        file.seekg(0);
+        file.read(&head[0], head.size());
+        return head != signature;
     }
 
-    // Load Data into a dataframe
-    DataFrame df = DataFrame(data, headers);
+   public:
+    /**
+     * @brief Constructs a follower of a CSV file, nothing is read until the first poll.
+     *
+     * @param csvFilePath The path to the CSV file to follow, it does not have to exist yet.
+     * @param delimiter The delimiter used to separate columns (default is comma `,`).
+     * @param header The line number that contains the column headers, lines before it are skipped. If `header` is -1,
+     * no headers are read from the file.
+     * @param names A vector of column names to use if `header` is specified as -1, otherwise it uses the first line as
+     * headers.
+     * @throws std::invalid_argument If `header` is -1 and no names are given.
+     */
+    CsvFollower(std::string csvFilePath, char delimiter = ',', int header = 0, std::vector<std::string> names = {})
+        : csvFilePath(std::move(csvFilePath)), delimiter(delimiter), header(header), headers(std::move(names)) {
+        if (!headers.empty()) {
+            this->header = -1;
+            fieldTypes.assign(headers.size(), 0);
+        } else if (header < 0) {
+            throw std::invalid_argument("[cdf][CsvFollower] Column names are required when the CSV has no header");
+        }
+    }
 
-    return df;
+    /**
+     * @brief Parses the complete lines added to the file since the last poll and appends them to a DataFrame.
+     *
+     * Appending to a DataFrame without columns gives it the columns of the file, see `DataFrame::append`.
+     *
+     * @param df The DataFrame receiving the new rows.
+     * @return The number of rows appended, 0 if the file does not exist (yet) or has no new complete line.
+     * @throws std::runtime_error If the header of a rotated file differs from the header read before, or if the file
+     * is compressed.
+     */
+    size_t poll(DataFrame& df) {
+        CDF_TRACE_SPAN(span, "io::CsvFollower::poll");
+        std::ifstream file(csvFilePath, std::ios::binary);
+        if (!file.is_open()) {
+            return 0;
+        }
+        if (detectCompression(*file.rdbuf()) != Compression::None) {
+            throw std::runtime_error("[cdf][CsvFollower] " + csvFilePath +
+                                     " is compressed, only plain files can be followed");
+        }
+        file.seekg(0, std::ios::end);
+        std::streamoff size = file.tellg();
+        if (rotated(file, size)) {
+            offset = 0;
+            lineIdx = 0;
+            signature.clear();
+        }
+        if (size <= offset) {
+            return 0;
+        }
+
+        // Only the new bytes are read, up to the last complete line
+        std::string text(size - offset, '\0');
+        file.clear();
+        file.seekg(offset);
+        file.read(&text[0], text.size());
+        size_t complete = text.rfind('\n');
+        if (complete == std::string::npos) {
+            return 0;
+        }
+        text.resize(complete + 1);
+        offset += text.size();
+        if (signature.size() < signatureBytes) {
+            signature.resize(std::min<std::streamoff>(signatureBytes, offset));
+            file.seekg(0);
+            file.read(&signature[0], signature.size());
+        }
+
+        CDF_TRACE_PHASE(parse, "io::CsvFollower/parse_and_infer");
+        std::vector<std::vector<std::string>> cache;
+        bool inQuotes = false;
+        std::string quotedString = "";
+        std::string line;
+        std::istringstream lines(text);
+        while (std::getline(lines, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            int currIdx = lineIdx++;
+            if (currIdx < header || line.empty()) {
+                continue;
+            }
+            if (currIdx == header) {
+                std::vector<std::string> names;
+                std::string val;
+                std::stringstream valueStream(line);
+                while (std::getline(valueStream, val, delimiter)) {
+                    names.push_back(val);
+                }
+                if (!headers.empty() && names != headers) {
+                    throw std::runtime_error("[cdf][CsvFollower] Header of " + csvFilePath + " has changed");
+                }
+                headers = names;
+                fieldTypes.resize(headers.size(), 0);
+                continue;
+            }
+            std::vector<std::string> rowVector;
+            splitCSVLine(line, delimiter, rowVector, inQuotes, quotedString);
+            inferFieldTypes(rowVector, fieldTypes);
+            cache.push_back(std::move(rowVector));
+        }
+        parse.rowsIn(cache.size());
+        parse.rowsOut(cache.size());
+        parse.end();
+        if (cache.empty()) {
+            return 0;
+        }
+
+        CDF_TRACE_PHASE(convert, "io::CsvFollower/convert");
+        convert.rowsIn(cache.size());
+        convert.rowsOut(cache.size());
+        size_t rows = cache.size();
+        df.append(DataFrame(convertFields(cache, fieldTypes), headers));
+        span.rowsOut(rows);
+        return rows;
+    }
+
+    /**
+     * @brief Returns the byte offset of the first line not read yet.
+     */
+    std::streamoff position() const { return offset; }
+
+    /**
+     * @brief Returns the data-types inferred so far, one per column.
+     */
+    std::vector<cdfDTypes> dtypes() const {
+        std::vector<cdfDTypes> types;
+        for (int rank : fieldTypes) {
+            types.push_back(static_cast<cdfDTypes>(rank));
+        }
+        return types;
+    }
 };
 
 }  // namespace io
@@ -0,0 +1,508 @@
+#ifndef KERNELS_HPP
+#define KERNELS_HPP
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "dtypes.hpp"
+
+namespace cdf {
+
+/**
+ * @brief Typed compute kernels working on contiguous buffers.
+ *
+ * The kernels run over plain `int64_t`/`double` arrays with a byte-per-row validity mask (1 for a value, 0 for a
+ * nan-value) instead of `_cdfVal` variants. Loops keep several independent accumulators so the compiler can map them
+ * onto SIMD lanes.
+ */
+namespace kernels {
+
+/**
+ * @brief Number of values summed sequentially before pairwise summation splits the range
+ */
+const size_t pairwiseBlock = 128;
+
+/**
+ * @brief Number of independent accumulators used by the reduction loops
+ */
+const size_t lanes = 8;
+
+/**
+ * @brief A numeric column materialized into a typed buffer.
+ *
+ * Integer-only columns are kept as 64-bit integers, columns holding at least one double are promoted to doubles.
+ * Slots of nan-values hold 0, so sums can ignore the validity mask.
+ */
+struct TypedColumn {
+    bool isInt = true;
+    std::vector<int64_t> ints;    /**< Values when isInt is true */
+    std::vector<double> doubles;  /**< Values when isInt is false */
+    std::vector<uint8_t> validity; /**< 1 for a value, 0 for a nan-value */
+    size_t nullCount = 0;
+
+    size_t size() const { return validity.size(); }
+
+    /**
+     * @brief Returns the number of bytes held by the buffers.
+     */
+    size_t memoryBytes() const {
+        return ints.capacity() * sizeof(int64_t) + doubles.capacity() * sizeof(double) + validity.capacity();
+    }
+};
+
+/**
+ * @brief Materializes numeric variant values into a typed buffer
+ *
+ * @param values The variant values
+ * @returns The typed column
+ * @throws std::runtime_error if string type field is found
+ */
+TypedColumn toTypedColumn(const std::vector<_cdfVal>& values) {
+    TypedColumn column;
+    column.validity.resize(values.size(), 1);
+    column.ints.resize(values.size(), 0);
+
+    for (size_t i = 0; i < values.size(); i++) {
+        const _cdfVal& value = values[i];
+        if (std::holds_alternative<int>(value)) {
+            if (column.isInt) {
+                column.ints[i] = std::get<int>(value);
+            } else {
+                column.doubles[i] = std::get<int>(value);
+            }
+        } else if (std::holds_alternative<double>(value)) {
+            if (column.isInt) {
+                // Promote the values seen so far
+                column.isInt = false;
+                column.doubles.assign(column.ints.begin(), column.ints.end());
+                column.ints.clear();
+                column.ints.shrink_to_fit();
+            }
+            column.doubles[i] = std::get<double>(value);
+        } else if (std::holds_alternative<NaN>(value)) {
+            column.validity[i] = 0;
+            ++column.nullCount;
+        } else {
+            throw std::runtime_error("String Data-Type isn't expected!");
+        }
+    }
+    return column;
+}
+
+/**
+ * @brief Concatenates typed buffers, integers are promoted to doubles if any part holds doubles
+ *
+ * @param parts The typed buffers, in order
+ * @returns The typed column holding the values of every part
+ */
+TypedColumn concatTyped(const std::vector<const TypedColumn*>& parts) {
+    TypedColumn column;
+    size_t n = 0;
+    for (const TypedColumn* part : parts) {
+        n += part->size();
+        column.isInt = column.isInt && part->isInt;
+        column.nullCount += part->nullCount;
+    }
+    column.validity.reserve(n);
+    if (column.isInt) {
+        column.ints.reserve(n);
+    } else {
+        column.doubles.reserve(n);
+    }
+    for (const TypedColumn* part : parts) {
+        column.validity.insert(column.validity.end(), part->validity.begin(), part->validity.end());
+        if (column.isInt) {
+            column.ints.insert(column.ints.end(), part->ints.begin(), part->ints.end());
+        } else if (part->isInt) {
+            column.doubles.insert(column.doubles.end(), part->ints.begin(), part->ints.end());
+        } else {
+            column.doubles.insert(column.doubles.end(), part->doubles.begin(), part->doubles.end());
+        }
+    }
+    return column;
+}
+
+/**
+ * @brief Sums `term(i)` over [0, n) with pairwise summation
+ *
+ * Blocks of `pairwiseBlock` terms are summed with `lanes` accumulators, blocks are combined pairwise. The rounding
+ * error grows with O(log n) instead of O(n) for a naive loop.
+ *
+ * @param n Number of terms
+ * @param term Callable returning the i-th term as double
+ * @returns Sum of the terms
+ */
+template <typename Term>
+double pairwiseSum(size_t begin, size_t n, const Term& term) {
+    if (n <= pairwiseBlock) {
+        double acc[lanes] = {0};
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            for (size_t k = 0; k < lanes; k++) {
+                acc[k] += term(begin + i + k);
+            }
+        }
+        double total = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+        for (; i < n; i++) {
+            total += term(begin + i);
+        }
+        return total;
+    }
+    // Keeping the split on a lane boundary keeps the inner loops full
+    size_t half = (n / 2) / lanes * lanes;
+    return pairwiseSum(begin, half, term) + pairwiseSum(begin + half, n - half, term);
+}
+
+/**
+ * @brief Sums doubles with pairwise summation
+ */
+double sum(const double* values, size_t n) {
+    return pairwiseSum(0, n, [values](size_t i) { return values[i]; });
+}
+
+/**
+ * @brief Sums integers with 64-bit accumulators
+ */
+int64_t sum(const int64_t* values, size_t n) {
+    int64_t acc[lanes] = {0};
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        for (size_t k = 0; k < lanes; k++) {
+            acc[k] += values[i + k];
+        }
+    }
+    int64_t total = 0;
+    for (size_t k = 0; k < lanes; k++) {
+        total += acc[k];
+    }
+    for (; i < n; i++) {
+        total += values[i];
+    }
+    return total;
+}
+
+/**
+ * @brief Counts the set entries of a validity mask
+ */
+size_t countValid(const uint8_t* validity, size_t n) {
+    size_t acc[lanes] = {0};
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        for (size_t k = 0; k < lanes; k++) {
+            acc[k] += validity[i + k];
+        }
+    }
+    size_t total = 0;
+    for (size_t k = 0; k < lanes; k++) {
+        total += acc[k];
+    }
+    for (; i < n; i++) {
+        total += validity[i];
+    }
+    return total;
+}
+
+/**
+ * @brief Finds the minimum (or maximum) of the valid values
+ *
+ * @tparam Greater Searches for the maximum when true
+ * @returns The extreme value, or the neutral element of the search if no value is valid
+ */
+template <bool Greater, typename T>
+T extreme(const T* values, const uint8_t* validity, size_t n) {
+    const T neutral = Greater ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+    T acc[lanes];
+    for (size_t k = 0; k < lanes; k++) {
+        acc[k] = neutral;
+    }
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        for (size_t k = 0; k < lanes; k++) {
+            T value = validity[i + k] ? values[i + k] : neutral;
+            acc[k] = Greater ? (value > acc[k] ? value : acc[k]) : (value < acc[k] ? value : acc[k]);
+        }
+    }
+    T result = neutral;
+    for (size_t k = 0; k < lanes; k++) {
+        result = Greater ? (acc[k] > result ? acc[k] : result) : (acc[k] < result ? acc[k] : result);
+    }
+    for (; i < n; i++) {
+        if (validity[i]) {
+            result = Greater ? (values[i] > result ? values[i] : result) : (values[i] < result ? values[i] : result);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Minimum of the valid values
+ */
+template <typename T>
+T min(const T* values, const uint8_t* validity, size_t n) {
+    return extreme<false>(values, validity, n);
+}
+
+/**
+ * @brief Maximum of the valid values
+ */
+template <typename T>
+T max(const T* values, const uint8_t* validity, size_t n) {
+    return extreme<true>(values, validity, n);
+}
+
+/**
+ * @brief Index of the first valid occurrence of the minimum (or maximum)
+ *
+ * @returns The index, or -1 if no value is valid
+ */
+template <bool Greater, typename T>
+long long argExtreme(const T* values, const uint8_t* validity, size_t n) {
+    if (countValid(validity, n) == 0) {
+        return -1;
+    }
+    T target = extreme<Greater>(values, validity, n);
+    for (size_t i = 0; i < n; i++) {
+        if (validity[i] && values[i] == target) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Index of the first minimum of the valid values, -1 if no value is valid
+ */
+template <typename T>
+long long argmin(const T* values, const uint8_t* validity, size_t n) {
+    return argExtreme<false>(values, validity, n);
+}
+
+/**
+ * @brief Index of the first maximum of the valid values, -1 if no value is valid
+ */
+template <typename T>
+long long argmax(const T* values, const uint8_t* validity, size_t n) {
+    return argExtreme<true>(values, validity, n);
+}
+
+/**
+ * @brief Sum of squared deviations of the valid values from a mean, second pass of the two-pass variance
+ */
+template <typename T>
+double sumSquaredDeviations(const T* values, const uint8_t* validity, size_t n, double mean) {
+    return pairwiseSum(0, n, [&](size_t i) {
+        double deviation = validity[i] ? static_cast<double>(values[i]) - mean : 0.0;
+        return deviation * deviation;
+    });
+}
+
+/**
+ * @brief Converts an integer to a variant value, a double if it is outside of the `int` range
+ */
+template <typename T>
+_cdfVal integerValue(T value) {
+    bool fits;
+    if constexpr (std::is_signed_v<T>) {
+        fits = static_cast<long long>(value) >= std::numeric_limits<int>::min() &&
+               static_cast<long long>(value) <= std::numeric_limits<int>::max();
+    } else {
+        fits = static_cast<unsigned long long>(value) <= static_cast<unsigned>(std::numeric_limits<int>::max());
+    }
+    if (fits) {
+        return static_cast<int>(value);
+    }
+    return static_cast<double>(value);
+}
+
+/**
+ * @brief Applies an arithmetic operator to two variant values
+ *
+ * Integer operands give an integer, except for divisions which always give a double, and results outside of the
+ * `int` range which are given as doubles. A nan-value on either side gives a nan-value.
+ *
+ * @tparam Op One of std::plus<>, std::minus<>, std::multiplies<>, std::divides<>
+ * @throws std::runtime_error if string type field is found
+ */
+template <typename Op>
+_cdfVal applyArithmetic(const _cdfVal& lhs, const _cdfVal& rhs) {
+    if (std::holds_alternative<NaN>(lhs) || std::holds_alternative<NaN>(rhs)) {
+        return NaN();
+    }
+    if (std::holds_alternative<std::string>(lhs) || std::holds_alternative<std::string>(rhs)) {
+        throw std::runtime_error("String Data-Type isn't expected!");
+    }
+    if (std::holds_alternative<int>(lhs) && std::holds_alternative<int>(rhs) &&
+        !std::is_same_v<Op, std::divides<>>) {
+        // Computed on 64 bits, where operations on two ints cannot overflow
+        return integerValue(Op{}(static_cast<int64_t>(std::get<int>(lhs)), static_cast<int64_t>(std::get<int>(rhs))));
+    }
+    double l = std::holds_alternative<int>(lhs) ? std::get<int>(lhs) : std::get<double>(lhs);
+    double r = std::holds_alternative<int>(rhs) ? std::get<int>(rhs) : std::get<double>(rhs);
+    return Op{}(l, r);
+}
+
+/**
+ * @brief Converts a typed buffer back to variant values
+ *
+ * Integers outside of the `int` range are stored as doubles.
+ */
+std::vector<_cdfVal> toValues(const TypedColumn& column) {
+    std::vector<_cdfVal> values;
+    values.reserve(column.size());
+    for (size_t i = 0; i < column.size(); i++) {
+        if (!column.validity[i]) {
+            values.push_back(NaN());
+        } else if (!column.isInt) {
+            values.push_back(column.doubles[i]);
+        } else {
+            values.push_back(integerValue(column.ints[i]));
+        }
+    }
+    return values;
+}
+
+/**
+ * @brief Calls `f` with a pointer to the values of a typed buffer, `const int64_t*` or `const double*`
+ */
+template <typename F>
+void visitValues(const TypedColumn& column, const F& f) {
+    if (column.isInt) {
+        f(column.ints.data());
+    } else {
+        f(column.doubles.data());
+    }
+}
+
+/**
+ * @brief Computes `out[i] = op(lhs(i), rhs(i))` in the output type, a branch-free loop the compiler can vectorize
+ */
+template <typename Op, typename Out, typename LhsAt, typename RhsAt>
+void elementwise(Out* out, size_t n, const LhsAt& lhs, const RhsAt& rhs) {
+    const Op op{};
+    for (size_t i = 0; i < n; i++) {
+        out[i] = op(static_cast<Out>(lhs(i)), static_cast<Out>(rhs(i)));
+    }
+}
+
+/**
+ * @brief Restores the invariants of a computed buffer: nan-values hold 0, doubles which are NaN become nan-values
+ */
+void finishColumn(TypedColumn& column) {
+    size_t n = column.size();
+    if (column.isInt) {
+        int64_t* values = column.ints.data();
+        for (size_t i = 0; i < n; i++) {
+            values[i] = column.validity[i] ? values[i] : 0;
+        }
+    } else {
+        double* values = column.doubles.data();
+        for (size_t i = 0; i < n; i++) {
+            column.validity[i] = column.validity[i] && values[i] == values[i];
+            values[i] = column.validity[i] ? values[i] : 0.0;
+        }
+    }
+    column.nullCount = n - countValid(column.validity.data(), n);
+}
+
+/**
+ * @brief Fills the values of a result buffer whose type and validity are already set
+ */
+template <typename Op, typename LhsAt, typename RhsAt>
+void storeResult(TypedColumn& result, const LhsAt& lhs, const RhsAt& rhs) {
+    if (result.isInt) {
+        result.ints.resize(result.size());
+        elementwise<Op>(result.ints.data(), result.size(), lhs, rhs);
+    } else {
+        result.ints.clear();
+        result.doubles.resize(result.size());
+        elementwise<Op>(result.doubles.data(), result.size(), lhs, rhs);
+    }
+    finishColumn(result);
+}
+
+/**
+ * @brief Applies an arithmetic operator element-wise to two typed buffers of the same size
+ *
+ * Follows `applyArithmetic`: integers give integers except for divisions, a nan-value on either side gives a
+ * nan-value.
+ *
+ * @tparam Op One of std::plus<>, std::minus<>, std::multiplies<>, std::divides<>
+ */
+template <typename Op>
+TypedColumn binaryOp(const TypedColumn& lhs, const TypedColumn& rhs) {
+    TypedColumn result;
+    result.isInt = lhs.isInt && rhs.isInt && !std::is_same_v<Op, std::divides<>>;
+    result.validity.resize(lhs.size());
+    for (size_t i = 0; i < lhs.size(); i++) {
+        result.validity[i] = lhs.validity[i] & rhs.validity[i];
+    }
+    visitValues(lhs, [&](auto a) {
+        visitValues(rhs, [&](auto b) {
+            storeResult<Op>(result, [a](size_t i) { return a[i]; }, [b](size_t i) { return b[i]; });
+        });
+    });
+    return result;
+}
+
+/**
+ * @brief Applies an arithmetic operator between every value of a typed buffer and a scalar
+ *
+ * @tparam Op One of std::plus<>, std::minus<>, std::multiplies<>, std::divides<>
+ * @param scalar An int64_t or a double, an integer keeps integer columns integral except for divisions
+ * @param scalarFirst Computes `op(scalar, value)` instead of `op(value, scalar)`
+ */
+template <typename Op, typename T>
+TypedColumn scalarOp(const TypedColumn& column, T scalar, bool scalarFirst) {
+    TypedColumn result;
+    result.isInt = column.isInt && std::is_integral_v<T> && !std::is_same_v<Op, std::divides<>>;
+    result.validity = column.validity;
+    visitValues(column, [&](auto a) {
+        auto values = [a](size_t i) { return a[i]; };
+        auto constant = [scalar](size_t) { return scalar; };
+        if (scalarFirst) {
+            storeResult<Op>(result, constant, values);
+        } else {
+            storeResult<Op>(result, values, constant);
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief Applies a function to every value of a typed buffer
+ *
+ * @param keepInt Keeps integer columns integral, `f` is then called with int64_t values
+ * @param f The function, called with double values unless keepInt applies
+ */
+template <typename F>
+TypedColumn unaryOp(const TypedColumn& column, bool keepInt, const F& f) {
+    TypedColumn result;
+    result.isInt = column.isInt && keepInt;
+    result.validity = column.validity;
+    visitValues(column, [&](auto a) {
+        if (result.isInt) {
+            result.ints.resize(column.size());
+            for (size_t i = 0; i < column.size(); i++) {
+                result.ints[i] = f(static_cast<int64_t>(a[i]));
+            }
+        } else {
+            result.ints.clear();
+            result.doubles.resize(column.size());
+            for (size_t i = 0; i < column.size(); i++) {
+                result.doubles[i] = f(static_cast<double>(a[i]));
+            }
+        }
+    });
+    finishColumn(result);
+    return result;
+}
+
+}  // namespace kernels
+
+}  // namespace cdf
+
+#endif
@@ -0,0 +1,802 @@
+#ifndef LAZY_HPP
+#define LAZY_HPP
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "data.hpp"
+#include "dataframe.hpp"
+#include "dtypes.hpp"
+#include "input.hpp"
+#include "trace.hpp"
+#include "utils.hpp"
+
+namespace cdf {
+
+/**
+ * @brief Comparison operators usable in lazy filters.
+ */
+enum class CompareOp { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual };
+
+/**
+ * @brief Aggregations usable in lazy plans.
+ */
+enum class AggOp { Count, Sum, Mean, Min, Max };
+
+/**
+ * @brief Compares a value with the semantics of the `core::Series` comparison operators.
+ *
+ * @param cell The value to compare.
+ * @param op The comparison operator.
+ * @param value The value to compare against, its type selects the string, integer or double comparison.
+ * @return The result of the comparison, false for nan-values.
+ */
+bool evaluateCompare(const _cdfVal& cell, CompareOp op, const _cdfVal& value) {
+    return std::visit(
+        [&](const auto& v) -> bool {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, NaN>) {
+                return false;
+            } else {
+                switch (op) {
+                    case CompareOp::Equal:
+                        return core::compareValue(cell, v, std::equal_to<>{});
+                    case CompareOp::NotEqual:
+                        return core::compareValue(cell, v, std::not_equal_to<>{});
+                    case CompareOp::Less:
+                        return core::compareValue(cell, v, std::less<>{});
+                    case CompareOp::LessEqual:
+                        return core::compareValue(cell, v, std::less_equal<>{});
+                    case CompareOp::Greater:
+                        return core::compareValue(cell, v, std::greater<>{});
+                    default:
+                        return core::compareValue(cell, v, std::greater_equal<>{});
+                }
+            }
+        },
+        value);
+}
+
+/**
+ * @class LazyFrame
+ * @brief A query recorded as a logical plan and executed on `collect()`.
+ *
+ * Every builder method returns a new LazyFrame with one more step, nothing is computed until `collect()`. Before
+ * execution the plan is optimized:
+ * - filters are pushed below projections and sorts, adjacent filters, projections and limits are fused,
+ * - only the source columns used by the plan are read (projection pushdown),
+ * - the leading filters are evaluated while scanning the source, for CSV files while parsing (predicate pushdown).
+ *
+ * The optimized plan then runs as a pipeline: the source is scanned in batches of `batchSize` rows, and each batch
+ * flows through all the consecutive filter/projection/limit steps in a single loop. Only sorts and aggregations
+ * break the pipeline, aggregations are accumulated on the fly without materializing their input.
+ *
+ * A LazyFrame created with `DataFrame::lazy()` refers to the DataFrame, which has to outlive it.
+ */
+class LazyFrame {
+   public:
+    /**
+     * @brief A `column op value` condition.
+     */
+    struct Predicate {
+        std::string column;
+        CompareOp op;
+        _cdfVal value;
+    };
+
+    /**
+     * @brief An aggregation of one column, named `op(column)` in the result.
+     */
+    struct Aggregation {
+        std::string column;
+        AggOp op;
+    };
+
+   private:
+    enum class StepKind { Filter, Select, Sort, Limit, Aggregate };
+
+    struct Step {
+        StepKind kind = StepKind::Filter;
+        std::vector<Predicate> predicates;      /**< Filter: conjunction of conditions */
+        std::vector<std::string> columns;       /**< Select: projected columns */
+        std::string sortColumn;                 /**< Sort: sorting key */
+        bool ascending = true;                  /**< Sort: sorting order */
+        size_t limit = 0;                       /**< Limit: maximum number of rows */
+        std::vector<Aggregation> aggregations;  /**< Aggregate: aggregations */
+    };
+
+    // Rows flowing between the operators, a batch is a contiguous range of rows
+    using RowValues = std::vector<_cdfVal>;
+    using BatchConsumer = std::function<bool(const RowValues* rows, size_t count)>;
+
+    // Filters of a pipeline segment followed by the limit applied to the rows they keep
+    struct Gate {
+        std::vector<std::pair<int, const Predicate*>> predicates;
+        size_t remaining = std::numeric_limits<size_t>::max();
+    };
+
+    DataFrame* frame = nullptr;
+    std::string csvPath;
+    char delimiter = ',';
+    int header = 0;
+    std::vector<std::string> names;
+    std::vector<Step> steps;
+    size_t batchSize = 4096;
+
+    LazyFrame withStep(const Step& step) const {
+        LazyFrame next = *this;
+        next.steps.push_back(step);
+        return next;
+    }
+
+    static std::string aggregationName(const Aggregation& aggregation) {
+        static const char* opNames[] = {"count", "sum", "mean", "min", "max"};
+        return std::string(opNames[static_cast<int>(aggregation.op)]) + "(" + aggregation.column + ")";
+    }
+
+    static int findColumn(const std::vector<std::string>& schema, const std::string& column) {
+        auto it = std::find(schema.begin(), schema.end(), column);
+        if (it == schema.end()) {
+            std::string errorMessage = "[cdf][LazyFrame] " + column + " not present inside dataframe object!";
+            throw std::out_of_range(errorMessage);
+        }
+        return it - schema.begin();
+    }
+
+    /**
+     * @brief Columns of the source, read from the CSV header if needed
+     */
+    std::vector<std::string> sourceColumns() const {
+        if (frame) {
+            return frame->columns;
+        }
+        if (!names.empty()) {
+            return names;
+        }
+        if (header < 0) {
+            throw std::invalid_argument("[cdf][LazyFrame] Column names are required when the CSV has no header");
+        }
+
+        io::InputFile csvFile(csvPath);
+        if (!csvFile.is_open()) {
+            throw std::ios_base::failure("Unable to load " + csvPath + " !");
+        }
+        std::string line, val;
+        for (int currIdx = 0; std::getline(csvFile, line); currIdx++) {
+            if (currIdx == header) {
+                std::vector<std::string> headers;
+                std::stringstream headerStream(line);
+                while (std::getline(headerStream, val, delimiter)) {
+                    headers.push_back(val);
+                }
+                return headers;
+            }
+        }
+        return {};
+    }
+
+    /**
+     * @brief Checks that every step refers to columns available at its position in the plan
+     */
+    void validate(std::vector<std::string> schema) const {
+        for (auto& step : steps) {
+            switch (step.kind) {
+                case StepKind::Filter:
+                    for (auto& predicate : step.predicates) {
+                        findColumn(schema, predicate.column);
+                    }
+                    break;
+                case StepKind::Select:
+                    for (auto& column : step.columns) {
+                        findColumn(schema, column);
+                    }
+                    schema = step.columns;
+                    break;
+                case StepKind::Sort:
+                    findColumn(schema, step.sortColumn);
+                    break;
+                case StepKind::Aggregate: {
+                    std::vector<std::string> outputSchema;
+                    for (auto& aggregation : step.aggregations) {
+                        findColumn(schema, aggregation.column);
+                        outputSchema.push_back(aggregationName(aggregation));
+                    }
+                    schema = outputSchema;
+                    break;
+                }
+                case StepKind::Limit:
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief Source columns read by the plan, in source order
+     */
+    static std::vector<int> requiredColumns(const std::vector<Step>& plan, const std::vector<std::string>& source) {
+        std::vector<bool> used(source.size(), false);
+        for (auto& step : plan) {
+            if (step.kind == StepKind::Filter) {
+                for (auto& predicate : step.predicates) {
+                    used[findColumn(source, predicate.column)] = true;
+                }
+            } else if (step.kind == StepKind::Sort) {
+                used[findColumn(source, step.sortColumn)] = true;
+            } else if (step.kind == StepKind::Select || step.kind == StepKind::Aggregate) {
+                // Later steps only see the columns produced here
+                for (auto& column : step.columns) {
+                    used[findColumn(source, column)] = true;
+                }
+                for (auto& aggregation : step.aggregations) {
+                    used[findColumn(source, aggregation.column)] = true;
+                }
+                std::vector<int> required;
+                for (size_t j = 0; j < used.size(); j++) {
+                    if (used[j]) {
+                        required.push_back(j);
+                    }
+                }
+                return required;
+            }
+        }
+
+        std::vector<int> required(source.size());
+        for (size_t j = 0; j < source.size(); j++) {
+            required[j] = j;
+        }
+        return required;
+    }
+
+    /**
+     * @brief Checks a row against a conjunction of resolved predicates, stops at the first failing one
+     */
+    template <typename Cell>
+    static bool matches(const std::vector<std::pair<int, const Predicate*>>& predicates, const Cell& cell) {
+        for (auto& [position, predicate] : predicates) {
+            if (!evaluateCompare(cell(position), predicate->op, predicate->value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Scans the DataFrame source, evaluating the pushed predicates before copying the required columns
+     */
+    void scanFrame(const std::vector<int>& required, const std::vector<Predicate>& pushed,
+                   const BatchConsumer& consume) const {
+        std::vector<std::pair<int, const Predicate*>> predicates;
+        for (auto& predicate : pushed) {
+            predicates.push_back({findColumn(frame->columns, predicate.column), &predicate});
+        }
+
+        std::vector<RowValues> batch(batchSize, RowValues(required.size()));
+        size_t filled = 0;
+        for (size_t i = 0; i < frame->data.size(); i++) {
+            core::Data::RowView row = frame->data.row(i);
+            if (!matches(predicates, [&](int position) -> const _cdfVal& { return row[position]; })) {
+                continue;
+            }
+            for (size_t k = 0; k < required.size(); k++) {
+                batch[filled][k] = row[required[k]];
+            }
+            if (++filled == batchSize) {
+                if (!consume(batch.data(), filled)) {
+                    return;
+                }
+                filled = 0;
+            }
+        }
+        if (filled > 0) {
+            consume(batch.data(), filled);
+        }
+    }
+
+    /**
+     * @brief Parses the CSV source, keeping only the required fields of the rows passing the pushed predicates
+     *
+     * Column types are inferred over every row of the file, like `io::read_csv`, so the result holds the same values.
+     */
+    std::vector<RowValues> scanCsv(const std::vector<int>& required, const std::vector<std::string>& source,
+                                   const std::vector<Predicate>& pushed) const {
+        CDF_TRACE_PHASE(span, "LazyFrame::scan_csv");
+        std::vector<int> requiredPosition(source.size(), -1);
+        for (size_t k = 0; k < required.size(); k++) {
+            requiredPosition[required[k]] = k;
+        }
+        std::vector<std::pair<int, const Predicate*>> predicates;
+        for (auto& predicate : pushed) {
+            predicates.push_back({requiredPosition[findColumn(source, predicate.column)], &predicate});
+        }
+
+        io::InputFile csvFile(csvPath);
+        if (!csvFile.is_open()) {
+            throw std::ios_base::failure("Unable to load " + csvPath + " !");
+        }
+
+        std::vector<int> fieldTypes(required.size(), 0);
+        std::vector<std::vector<std::string>> cache;
+        std::vector<std::string> fields;
+        RowValues converted(required.size());
+        std::string line, quotedString;
+        bool inQuotes = false;
+        int headerIdx = names.empty() ? header : -1;
+
+        for (int currIdx = 0; std::getline(csvFile, line); currIdx++) {
+            if (currIdx == headerIdx) {
+                continue;
+            }
+            io::splitCSVLine(line, delimiter, fields, inQuotes, quotedString);
+            for (size_t k = 0; k < required.size(); k++) {
+                const std::string& field = required[k] < static_cast<int>(fields.size()) ? fields[required[k]] : "";
+                if (field == "") {
+                    converted[k] = NaN();
+                    continue;
+                }
+                std::pair<int, _cdfVal> inferredData = inferAndConvert(field);
+                fieldTypes[k] = std::max(fieldTypes[k], inferredData.first);
+                converted[k] = inferredData.second;
+            }
+            if (!matches(predicates, [&](int position) -> const _cdfVal& { return converted[position]; })) {
+                continue;
+            }
+
+            std::vector<std::string> kept(required.size());
+            for (size_t k = 0; k < required.size(); k++) {
+                kept[k] = required[k] < static_cast<int>(fields.size()) ? fields[required[k]] : "";
+            }
+            cache.push_back(kept);
+        }
+
+        std::vector<RowValues> rows(cache.size(), RowValues(required.size()));
+        for (size_t i = 0; i < cache.size(); i++) {
+            for (size_t k = 0; k < required.size(); k++) {
+                const std::string& field = cache[i][k];
+                if (field == "") {
+                    rows[i][k] = NaN();
+                } else if (fieldTypes[k] == 0) {
+                    rows[i][k] = std::stoi(field);
+                } else if (fieldTypes[k] == 1) {
+                    rows[i][k] = std::stod(field);
+                } else {
+                    rows[i][k] = field;
+                }
+            }
+        }
+        return rows;
+    }
+
+    /**
+     * @brief Accumulates one aggregation over the rows flowing into it
+     */
+    struct Accumulator {
+        AggOp op;
+        size_t count = 0;
+        double sum = 0, compensation = 0;
+        _cdfVal extreme = NaN();
+
+        Accumulator(AggOp op) : op(op) {}
+
+        void add(const _cdfVal& value) {
+            if (std::holds_alternative<NaN>(value)) {
+                return;
+            }
+            ++count;
+            if (op == AggOp::Sum || op == AggOp::Mean) {
+                if (std::holds_alternative<std::string>(value)) {
+                    throw std::runtime_error("String Data-Type isn't expected!");
+                }
+                // Kahan summation
+                double term = (std::holds_alternative<int>(value) ? std::get<int>(value) : std::get<double>(value));
+                double y = term - compensation;
+                double t = sum + y;
+                compensation = (t - sum) - y;
+                sum = t;
+            } else if (op == AggOp::Min || op == AggOp::Max) {
+                bool replace = count == 1 || (op == AggOp::Min ? valueLess(value, extreme) : valueLess(extreme, value));
+                if (replace) {
+                    extreme = value;
+                }
+            }
+        }
+
+        _cdfVal result() const {
+            switch (op) {
+                case AggOp::Count:
+                    return static_cast<int>(count);
+                case AggOp::Sum:
+                    return sum;
+                case AggOp::Mean:
+                    return count == 0 ? _cdfVal(NaN()) : _cdfVal(sum / count);
+                default:
+                    return extreme;
+            }
+        }
+    };
+
+    /**
+     * @brief Sorts rows on one position, nan-values last in both orders
+     */
+    static void sortRows(std::vector<RowValues>& rows, int position, bool ascending, size_t limit) {
+        auto before = [position, ascending](const RowValues& a, const RowValues& b) {
+            bool aNaN = std::holds_alternative<NaN>(a[position]), bNaN = std::holds_alternative<NaN>(b[position]);
+            if (aNaN || bNaN) {
+                return !aNaN && bNaN;
+            }
+            return ascending ? valueLess(a[position], b[position]) : valueLess(b[position], a[position]);
+        };
+        if (limit < rows.size()) {
+            // Sort followed by a limit only needs the top rows, ties are broken by position like the stable sort
+            std::vector<size_t> order(rows.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::partial_sort(order.begin(), order.begin() + limit, order.end(), [&](size_t a, size_t b) {
+                return before(rows[a], rows[b]) || (!before(rows[b], rows[a]) && a < b);
+            });
+            std::vector<RowValues> top;
+            top.reserve(limit);
+            for (size_t k = 0; k < limit; k++) {
+                top.push_back(std::move(rows[order[k]]));
+            }
+            rows = std::move(top);
+        } else {
+            std::stable_sort(rows.begin(), rows.end(), before);
+        }
+    }
+
+    static std::string describeStep(const Step& step) {
+        static const char* opSymbols[] = {"==", "!=", "<", "<=", ">", ">="};
+        std::string text;
+        switch (step.kind) {
+            case StepKind::Filter:
+                text = "FILTER";
+                for (size_t i = 0; i < step.predicates.size(); i++) {
+                    const Predicate& predicate = step.predicates[i];
+                    text += (i ? " AND " : " ") + predicate.column + " " +
+                            opSymbols[static_cast<int>(predicate.op)] + " " + toString(predicate.value);
+                }
+                break;
+            case StepKind::Select:
+                text = "SELECT";
+                for (auto& column : step.columns) {
+                    text += " " + column;
+                }
+                break;
+            case StepKind::Sort:
+                text = "SORT " + step.sortColumn + (step.ascending ? " ASC" : " DESC");
+                break;
+            case StepKind::Limit:
+                text = "LIMIT " + std::to_string(step.limit);
+                break;
+            case StepKind::Aggregate:
+                text = "AGGREGATE";
+                for (auto& aggregation : step.aggregations) {
+                    text += " " + aggregationName(aggregation);
+                }
+                break;
+        }
+        return text;
+    }
+
+    /**
+     * @brief Rewrites the steps into the optimized logical plan
+     */
+    std::vector<Step> optimize() const {
+        std::vector<Step> plan;
+        for (auto& step : steps) {
+            if (step.kind == StepKind::Filter) {
+                // Filters don't depend on the order or the projection of the rows
+                size_t position = plan.size();
+                while (position > 0 &&
+                       (plan[position - 1].kind == StepKind::Select || plan[position - 1].kind == StepKind::Sort)) {
+                    --position;
+                }
+                if (position > 0 && plan[position - 1].kind == StepKind::Filter) {
+                    std::vector<Predicate>& predicates = plan[position - 1].predicates;
+                    predicates.insert(predicates.end(), step.predicates.begin(), step.predicates.end());
+                } else {
+                    plan.insert(plan.begin() + position, step);
+                }
+            } else if (step.kind == StepKind::Select && !plan.empty() && plan.back().kind == StepKind::Select) {
+                plan.back().columns = step.columns;
+            } else if (step.kind == StepKind::Limit && !plan.empty() && plan.back().kind == StepKind::Limit) {
+                plan.back().limit = std::min(plan.back().limit, step.limit);
+            } else {
+                plan.push_back(step);
+            }
+        }
+        return plan;
+    }
+
+   public:
+    /**
+     * @brief Starts a plan reading from an existing DataFrame.
+     *
+     * @param frame The source DataFrame, it has to outlive the LazyFrame.
+     * @param batchSize Number of rows flowing through the pipeline at once (default is 4096).
+     */
+    explicit LazyFrame(DataFrame& frame, size_t batchSize = 4096) : frame(&frame), batchSize(batchSize) {}
+
+    /**
+     * @brief Starts a plan reading from a CSV file, see `io::read_csv` for the parameters.
+     *
+     * @param batchSize Number of rows flowing through the pipeline at once (default is 4096).
+     */
+    LazyFrame(std::string csvPath, char delimiter = ',', int header = 0, std::vector<std::string> names = {},
+              size_t batchSize = 4096)
+        : csvPath(csvPath), delimiter(delimiter), header(header), names(names), batchSize(batchSize) {}
+
+    /**
+     * @brief Keeps the rows where `column op value` holds, with the semantics of the Series comparisons.
+     */
+    LazyFrame filter(const std::string& column, CompareOp op, const _cdfVal& value) const {
+        Step step;
+        step.kind = StepKind::Filter;
+        step.predicates.push_back({column, op, value});
+        return withStep(step);
+    }
+
+    /**
+     * @brief Keeps the given columns, in the given order.
+     */
+    LazyFrame select(const std::vector<std::string>& columns) const {
+        Step step;
+        step.kind = StepKind::Select;
+        step.columns = columns;
+        return withStep(step);
+    }
+
+    /**
+     * @brief Sorts the rows on a column, nan-values are placed last.
+     */
+    LazyFrame sort(const std::string& column, bool ascending = true) const {
+        Step step;
+        step.kind = StepKind::Sort;
+        step.sortColumn = column;
+        step.ascending = ascending;
+        return withStep(step);
+    }
+
+    /**
+     * @brief Keeps the first rows.
+     */
+    LazyFrame limit(size_t numRows) const {
+        Step step;
+        step.kind = StepKind::Limit;
+        step.limit = numRows;
+        return withStep(step);
+    }
+
+    /**
+     * @brief Reduces the rows into a single row holding one column per aggregation.
+     *
+     * Count counts the non-nan values, sum and mean expect numeric values, min and max also order strings.
+     */
+    LazyFrame aggregate(const std::vector<Aggregation>& aggregations) const {
+        Step step;
+        step.kind = StepKind::Aggregate;
+        step.aggregations = aggregations;
+        return withStep(step);
+    }
+
+    /**
+     * @brief Describes the optimized plan, one operator per line starting with the scan.
+     */
+    std::string explain() const {
+        std::vector<std::string> source = sourceColumns();
+        validate(source);
+        std::vector<Step> plan = optimize();
+
+        std::string text = frame ? "SCAN DataFrame [" : "SCAN CSV " + csvPath + " [";
+        std::vector<int> required = requiredColumns(plan, source);
+        for (size_t k = 0; k < required.size(); k++) {
+            text += (k ? ", " : "") + source[required[k]];
+        }
+        text += "]";
+
+        size_t first = 0;
+        if (!plan.empty() && plan[0].kind == StepKind::Filter) {
+            text += " PUSHED " + describeStep(plan[0]);
+            first = 1;
+        }
+        text += "\n";
+        for (size_t s = first; s < plan.size(); s++) {
+            text += describeStep(plan[s]) + "\n";
+        }
+        return text;
+    }
+
+    /**
+     * @brief Executes the plan.
+     *
+     * @return The resulting DataFrame.
+     * @throws std::out_of_range If a step refers to a column which is not available at its position in the plan.
+     */
+    DataFrame collect() const {
+        CDF_TRACE_SPAN(span, "LazyFrame::collect");
+        std::vector<std::string> source = sourceColumns();
+        validate(source);
+        std::vector<Step> plan = optimize();
+
+        std::vector<int> required = requiredColumns(plan, source);
+        std::vector<std::string> schema;
+        for (int idx : required) {
+            schema.push_back(source[idx]);
+        }
+
+        // Leading filters are evaluated by the scan itself
+        std::vector<Predicate> pushed;
+        size_t segmentStart = 0;
+        if (!plan.empty() && plan[0].kind == StepKind::Filter) {
+            pushed = plan[0].predicates;
+            segmentStart = 1;
+        }
+
+        std::vector<RowValues> materialized;
+        std::function<void(const BatchConsumer&)> produce;
+        if (frame) {
+            produce = [&](const BatchConsumer& consume) { scanFrame(required, pushed, consume); };
+        } else {
+            materialized = scanCsv(required, source, pushed);
+            produce = [&](const BatchConsumer& consume) {
+                for (size_t start = 0; start < materialized.size(); start += batchSize) {
+                    if (!consume(materialized.data() + start, std::min(batchSize, materialized.size() - start))) {
+                        return;
+                    }
+                }
+            };
+        }
+
+        while (true) {
+            // Fuse the streaming steps up to the next pipeline breaker into one loop
+            std::vector<int> positions(schema.size());
+            for (size_t k = 0; k < positions.size(); k++) {
+                positions[k] = k;
+            }
+            std::vector<std::string> segmentSchema = schema;
+            // Predicates and limits keep their order: a limit only counts the rows matching the filters before it
+            std::vector<Gate> gates(1);
+
+            size_t segmentEnd = segmentStart;
+            for (; segmentEnd < plan.size(); segmentEnd++) {
+                const Step& step = plan[segmentEnd];
+                if (step.kind == StepKind::Filter) {
+                    if (gates.back().remaining != std::numeric_limits<size_t>::max()) {
+                        gates.emplace_back();
+                    }
+                    for (auto& predicate : step.predicates) {
+                        gates.back().predicates.push_back(
+                            {positions[findColumn(segmentSchema, predicate.column)], &predicate});
+                    }
+                } else if (step.kind == StepKind::Select) {
+                    std::vector<int> projected;
+                    for (auto& column : step.columns) {
+                        projected.push_back(positions[findColumn(segmentSchema, column)]);
+                    }
+                    positions = projected;
+                    segmentSchema = step.columns;
+                } else if (step.kind == StepKind::Limit) {
+                    gates.back().remaining = std::min(gates.back().remaining, step.limit);
+                } else {
+                    break;
+                }
+            }
+
+            const Step* breaker = segmentEnd < plan.size() ? &plan[segmentEnd] : nullptr;
+            std::vector<Accumulator> accumulators;
+            std::vector<int> aggregatedPositions;
+            if (breaker && breaker->kind == StepKind::Aggregate) {
+                for (auto& aggregation : breaker->aggregations) {
+                    accumulators.emplace_back(aggregation.op);
+                    aggregatedPositions.push_back(positions[findColumn(segmentSchema, aggregation.column)]);
+                }
+            }
+
+            std::vector<RowValues> output;
+            // Once a limit is reached no later row can pass it
+            bool exhausted = false;
+            for (auto& gate : gates) {
+                exhausted = exhausted || gate.remaining == 0;
+            }
+            produce([&](const RowValues* rows, size_t count) {
+                for (size_t i = 0; i < count && !exhausted; i++) {
+                    const RowValues& row = rows[i];
+                    bool passed = true;
+                    for (auto& gate : gates) {
+                        if (!matches(gate.predicates, [&](int position) -> const _cdfVal& { return row[position]; })) {
+                            passed = false;
+                            break;
+                        }
+                        if (--gate.remaining == 0) {
+                            exhausted = true;
+                        }
+                    }
+                    if (!passed) {
+                        continue;
+                    }
+                    if (!accumulators.empty()) {
+                        for (size_t a = 0; a < accumulators.size(); a++) {
+                            accumulators[a].add(row[aggregatedPositions[a]]);
+                        }
+                        continue;
+                    }
+                    RowValues projected(positions.size());
+                    for (size_t k = 0; k < positions.size(); k++) {
+                        projected[k] = row[positions[k]];
+                    }
+                    output.push_back(std::move(projected));
+                }
+                return !exhausted;
+            });
+
+            if (!breaker) {
+                core::Data result(segmentSchema.size());
+                for (auto& row : output) {
+                    result.push_back(row);
+                }
+                return DataFrame(result, segmentSchema);
+            }
+
+            if (breaker->kind == StepKind::Sort) {
+                size_t limit = std::numeric_limits<size_t>::max();
+                if (segmentEnd + 1 < plan.size() && plan[segmentEnd + 1].kind == StepKind::Limit) {
+                    limit = plan[segmentEnd + 1].limit;
+                }
+                sortRows(output, findColumn(segmentSchema, breaker->sortColumn), breaker->ascending, limit);
+                schema = segmentSchema;
+            } else {
+                RowValues aggregated;
+                schema.clear();
+                for (size_t a = 0; a < accumulators.size(); a++) {
+                    aggregated.push_back(accumulators[a].result());
+                    schema.push_back(aggregationName(breaker->aggregations[a]));
+                }
+                output.assign(1, aggregated);
+            }
+
+            // The next segment reads the rows produced by the breaker
+            materialized = std::move(output);
+            produce = [&](const BatchConsumer& consume) {
+                for (size_t start = 0; start < materialized.size(); start += batchSize) {
+                    if (!consume(materialized.data() + start, std::min(batchSize, materialized.size() - start))) {
+                        return;
+                    }
+                }
+            };
+            segmentStart = segmentEnd + 1;
+        }
+    }
+};
+
+inline LazyFrame DataFrame::lazy() { return LazyFrame(*this); }
+
+namespace io {
+
+/**
+ * @brief Starts a lazy query over a CSV file.
+ *
+ * Unlike `read_csv`, the file is only read on `collect()`, and only the columns and rows needed by the query are
+ * materialized.
+ *
+ * @param csvFilePath The path to the CSV file to be loaded.
+ * @param delimiter The delimiter used to separate columns (default is comma `,`).
+ * @param header The line number that contains the column headers.
+ * @param names A vector of column names to use instead of the header line.
+ * @return A LazyFrame reading from the file.
+ */
+LazyFrame scan_csv(std::string csvFilePath, char delimiter = ',', int header = 0,
+                   std::vector<std::string> names = {}) {
+    return LazyFrame(csvFilePath, delimiter, header, names);
+}
+
+}  // namespace io
+
+}  // namespace cdf
+
+#endif
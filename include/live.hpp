@@ -0,0 +1,144 @@
+#ifndef LIVE_HPP
+#define LIVE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "data.hpp"
+#include "dataframe.hpp"
+#include "dtypes.hpp"
+#include "trace.hpp"
+
+namespace cdf {
+
+/**
+ * @class LiveFrame
+ * @brief A DataFrame growing under a writer thread while reader threads query it, with snapshot isolation.
+ *
+ * A DataFrame is not synchronized: appending to it while another thread reads it is a data race. A LiveFrame keeps a
+ * published version of the frame that readers copy with `snapshot()`, a copy sharing the column buffers, so it costs
+ * the number of columns. A snapshot never changes, whatever is appended afterwards, and stays valid as long as the
+ * reader keeps it.
+ *
+ * The writer appends to a private version of the frame, then publishes it by swapping a pointer. Column buffers
+ * shared with published versions are never modified (copy-on-write): appended rows go to new chunks, see
+ * `DataFrame::append`, so publishing copies no rows beyond a small last chunk. Readers only wait for that pointer swap,
+ * never for the writer to parse or append. Writer calls are serialized between themselves. Queries read the chunks in
+ * place, a new version is as fast to query as the previous one.
+ *
+ * Example:
+ * ```
+ * cdf::LiveFrame live(cdf::io::read_csv("history.csv"));
+ *
+ * // writer thread
+ * live.append(batch);
+ *
+ * // reader threads
+ * cdf::DataFrame df = live.snapshot();
+ * auto slow = df[cdf::col("latency") > 300];
+ * ```
+ */
+class LiveFrame {
+    mutable std::mutex publishMutex; /**< Guards `published` and `publishedVersion` */
+    std::shared_ptr<const DataFrame> published;
+    uint64_t publishedVersion = 0;
+
+    std::mutex writerMutex; /**< Serializes the writer calls */
+    DataFrame working;      /**< Version the writer appends to */
+    core::Data pending;     /**< Rows pushed since the last publication */
+
+    void flushPending() {
+        if (pending.size() > 0) {
+            working.append(DataFrame(std::move(pending), working.columns));
+            pending = core::Data(working.columns.size());
+        }
+    }
+
+    void publishWorking() {
+        CDF_TRACE_SPAN(span, "LiveFrame::publish");
+        flushPending();
+        // Copied outside the lock, readers only wait for the swap
+        auto next = std::make_shared<const DataFrame>(working);
+        std::lock_guard<std::mutex> lock(publishMutex);
+        published = std::move(next);
+        ++publishedVersion;
+    }
+
+   public:
+    /**
+     * @brief Constructs a live frame starting with the rows of a DataFrame, which are shared, not copied.
+     *
+     * @param initial The first version of the frame (default is an empty DataFrame, the first batch appended then
+     * gives the columns).
+     */
+    LiveFrame(DataFrame initial = {}) : working(std::move(initial)) {
+        pending = core::Data(working.columns.size());
+        publishWorking();
+    }
+
+    /**
+     * @brief Returns the latest published version of the frame, safe to query while the writer appends.
+     */
+    DataFrame snapshot() const {
+        std::shared_ptr<const DataFrame> current;
+        {
+            std::lock_guard<std::mutex> lock(publishMutex);
+            current = published;
+        }
+        return *current;
+    }
+
+    /**
+     * @brief Returns the number of versions published so far, it increases with every publication.
+     */
+    uint64_t version() const {
+        std::lock_guard<std::mutex> lock(publishMutex);
+        return publishedVersion;
+    }
+
+    /**
+     * @brief Appends the rows of a DataFrame, matching the columns by name, and publishes the new version.
+     *
+     * @param batch The rows to append.
+     * @throws std::invalid_argument If the columns of the batch differ.
+     */
+    void append(const DataFrame& batch) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        flushPending();
+        working.append(batch);
+        if (pending.colN != static_cast<int>(working.columns.size())) {
+            pending = core::Data(working.columns.size());
+        }
+        publishWorking();
+    }
+
+    /**
+     * @brief Adds a row, visible to readers after the next `publish()` or `append()`.
+     *
+     * Rows are gathered into one chunk per publication, so pushing rows one by one costs no more than appending
+     * them as a batch.
+     *
+     * @param row One value per column.
+     * @throws std::length_error if the size of the row does not match the number of columns.
+     */
+    void push_back(std::vector<_cdfVal> row) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        pending.push_back(std::move(row));
+    }
+
+    /**
+     * @brief Publishes the rows pushed since the last publication.
+     */
+    void publish() {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        if (pending.size() > 0) {
+            publishWorking();
+        }
+    }
+};
+
+}  // namespace cdf
+
+#endif
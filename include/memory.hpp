@@ -0,0 +1,329 @@
+#ifndef MEMORY_HPP
+#define MEMORY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "trace.hpp"
+
+namespace cdf {
+
+/**
+ * @class MemoryPool
+ * @brief A reusable pool for the temporary buffers of DataFrame operations.
+ *
+ * Masks, index vectors and other scratch buffers of an operation are allocated from the pool of the current
+ * `ScratchScope` instead of the global heap. Freed blocks go back to the pool and are handed out again to the next
+ * operation, so a loop of similar queries stops calling malloc once the pool is warm. The pool is not thread-safe,
+ * use one pool per thread.
+ *
+ * Example:
+ * ```
+ * cdf::MemoryPool pool;
+ * for (auto& request : requests) {
+ *     cdf::ScratchScope scope(pool);
+ *     auto result = df[cdf::col("Age") > request.minAge];
+ * }
+ * ```
+ */
+class MemoryPool {
+    std::pmr::unsynchronized_pool_resource pool;
+
+   public:
+    /**
+     * @brief Constructs an empty pool.
+     *
+     * @param largestBlock Largest allocation served from the pooled blocks, larger ones go to upstream directly
+     * (default is 4 MiB).
+     * @param upstream Resource the pool takes its memory from (default is the global heap).
+     */
+    explicit MemoryPool(size_t largestBlock = size_t(4) << 20,
+                        std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : pool(std::pmr::pool_options{0, largestBlock}, upstream) {}
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    /**
+     * @brief Returns the pool as a memory resource, for `std::pmr` containers.
+     */
+    std::pmr::memory_resource* resource() { return &pool; }
+
+    /**
+     * @brief Gives all the memory of the pool back to upstream, the buffers allocated from it must be gone.
+     */
+    void release() { pool.release(); }
+};
+
+namespace core {
+
+/**
+ * @brief Resource used for scratch buffers on the current thread
+ */
+std::pmr::memory_resource*& scratchSlot() {
+    static thread_local std::pmr::memory_resource* resource = nullptr;
+    return resource;
+}
+
+/**
+ * @brief Returns the resource scratch buffers are allocated from: the pool of the innermost `ScratchScope` of the
+ * current thread, the global heap otherwise.
+ */
+std::pmr::memory_resource* scratchResource() {
+    std::pmr::memory_resource* resource = scratchSlot();
+    return resource ? resource : std::pmr::new_delete_resource();
+}
+
+/**
+ * @brief A vector allocated from the scratch resource
+ */
+template <typename T>
+using ScratchVector = std::pmr::vector<T>;
+
+}  // namespace core
+
+/**
+ * @class ScratchScope
+ * @brief Routes the scratch buffers of the operations run on this thread to a pool while the scope is alive.
+ *
+ * Only temporaries use the pool, DataFrames and Series returned by the operations are allocated as usual and may
+ * outlive it. Scopes nest, the innermost one wins.
+ */
+class ScratchScope {
+    std::pmr::memory_resource* previous;
+
+   public:
+    explicit ScratchScope(MemoryPool& pool) : previous(core::scratchSlot()) { core::scratchSlot() = pool.resource(); }
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    ~ScratchScope() { core::scratchSlot() = previous; }
+};
+
+/**
+ * @brief Library-wide memory counters of the tracking allocator.
+ */
+struct MemoryStats {
+    size_t currentBytes = 0; /**< Bytes allocated and not freed yet */
+    size_t peakBytes = 0;    /**< Highest currentBytes since start or `reset_peak_memory()` */
+    size_t allocations = 0;  /**< Number of allocations */
+    size_t frees = 0;        /**< Number of deallocations */
+    size_t limitBytes = 0;   /**< Limit set by `set_memory_limit`, 0 when there is none */
+    bool tracked = false;    /**< Whether the tracking allocator is compiled in, every other field is 0 otherwise */
+};
+
+/**
+ * @class MemoryLimitExceeded
+ * @brief Thrown by an allocation which would take the tracked memory beyond the limit.
+ */
+class MemoryLimitExceeded : public std::bad_alloc {
+    std::string message;
+
+   public:
+    MemoryLimitExceeded(size_t requested, size_t current, size_t limit)
+        : message("[cdf][Memory] Allocating " + std::to_string(requested) + " bytes with " + std::to_string(current) +
+                  " bytes in use exceeds the limit of " + std::to_string(limit) + " bytes") {}
+
+    const char* what() const noexcept override { return message.c_str(); }
+};
+
+namespace core {
+
+/**
+ * @brief Counters updated by the tracking allocator, constant-initialized so allocations made before main are counted
+ */
+struct MemoryCounters {
+    std::atomic<size_t> current{0};
+    std::atomic<size_t> peak{0};
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> frees{0};
+    std::atomic<size_t> limit{0};
+    std::atomic<bool> tracked{false};
+};
+
+MemoryCounters& memoryCounters() {
+    static MemoryCounters counters;
+    return counters;
+}
+
+/**
+ * @brief Header stored in the 16 bytes before every block of the tracking allocator
+ */
+struct BlockHeader {
+    size_t size;   /**< Requested size */
+    size_t offset; /**< Distance from the start of the underlying allocation to the block */
+};
+
+/**
+ * @brief Allocates a tracked block, used by the replaced `operator new`
+ *
+ * @throws MemoryLimitExceeded if the block would take the tracked memory beyond the limit
+ * @throws std::bad_alloc if the system is out of memory
+ */
+void* trackedAllocate(size_t size, size_t alignment, bool nothrow) {
+    MemoryCounters& counters = memoryCounters();
+    counters.tracked.store(true, std::memory_order_relaxed);
+
+    size_t current = counters.current.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t limit = counters.limit.load(std::memory_order_relaxed);
+    if (limit > 0 && current > limit) {
+        counters.current.fetch_sub(size, std::memory_order_relaxed);
+        if (nothrow) {
+            return nullptr;
+        }
+        throw MemoryLimitExceeded(size, current - size, limit);
+    }
+
+    size_t offset = alignment > sizeof(BlockHeader) ? alignment : sizeof(BlockHeader);
+    size_t total = (size + offset + alignment - 1) / alignment * alignment;
+    void* raw = alignment > alignof(std::max_align_t) ? std::aligned_alloc(alignment, total) : std::malloc(total);
+    if (!raw) {
+        counters.current.fetch_sub(size, std::memory_order_relaxed);
+        if (nothrow) {
+            return nullptr;
+        }
+        throw std::bad_alloc();
+    }
+
+    size_t peak = counters.peak.load(std::memory_order_relaxed);
+    while (current > peak && !counters.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    trace::AllocationCounters& threadCounters = trace::threadAllocations();
+    threadCounters.bytes += size;
+    threadCounters.count++;
+
+    char* block = static_cast<char*>(raw) + offset;
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(block) - 1;
+    header->size = size;
+    header->offset = offset;
+    return block;
+}
+
+/**
+ * @brief Frees a block of `trackedAllocate`
+ */
+void trackedFree(void* block) {
+    if (!block) {
+        return;
+    }
+    BlockHeader* header = static_cast<BlockHeader*>(block) - 1;
+    MemoryCounters& counters = memoryCounters();
+    counters.current.fetch_sub(header->size, std::memory_order_relaxed);
+    counters.frees.fetch_add(1, std::memory_order_relaxed);
+    std::free(static_cast<char*>(block) - header->offset);
+}
+
+}  // namespace core
+
+/**
+ * @brief Returns the counters of the tracking allocator.
+ *
+ * The tracking allocator replaces the global `operator new` and `operator delete` of the program when
+ * `CDF_TRACK_MEMORY` is defined before including cdf in exactly one translation unit. It then counts every
+ * allocation of the process, and the spans of `cdf::trace` report the bytes and allocations of each operation.
+ * Without it, only `limitBytes` is set.
+ */
+MemoryStats memory_stats() {
+    core::MemoryCounters& counters = core::memoryCounters();
+    MemoryStats stats;
+    stats.currentBytes = counters.current;
+    stats.peakBytes = counters.peak;
+    stats.allocations = counters.allocations;
+    stats.frees = counters.frees;
+    stats.limitBytes = counters.limit;
+    stats.tracked = counters.tracked;
+    return stats;
+}
+
+/**
+ * @brief Restarts the peak from the bytes currently in use.
+ */
+void reset_peak_memory() { core::memoryCounters().peak = core::memoryCounters().current.load(); }
+
+/**
+ * @brief Sets the most bytes the process may hold, 0 removes the limit.
+ *
+ * With the tracking allocator, an allocation taking the tracked memory beyond the limit throws
+ * `cdf::MemoryLimitExceeded` (a `std::bad_alloc`), so the running operation fails before the system runs out of
+ * memory. The limit has no effect without the tracking allocator.
+ */
+void set_memory_limit(size_t bytes) { core::memoryCounters().limit = bytes; }
+
+/**
+ * @brief Returns the memory limit, 0 when there is none.
+ */
+size_t get_memory_limit() { return core::memoryCounters().limit; }
+
+}  // namespace cdf
+
+#if defined(CDF_TRACK_MEMORY) || defined(CDF_TRACE_ALLOCATIONS)
+
+void* operator new(std::size_t size) { return cdf::core::trackedAllocate(size, alignof(std::max_align_t), false); }
+
+void* operator new[](std::size_t size) { return cdf::core::trackedAllocate(size, alignof(std::max_align_t), false); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return cdf::core::trackedAllocate(size, alignof(std::max_align_t), true);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return cdf::core::trackedAllocate(size, static_cast<size_t>(alignment), false);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return cdf::core::trackedAllocate(size, static_cast<size_t>(alignment), false);
+}
+
+// Kept out of line, so the compiler does not pair the inlined free with a new expression
+#if defined(__GNUC__) || defined(__clang__)
+#define CDF_MEMORY_NOINLINE __attribute__((noinline))
+#else
+#define CDF_MEMORY_NOINLINE
+#endif
+
+CDF_MEMORY_NOINLINE void operator delete(void* block) noexcept { cdf::core::trackedFree(block); }
+
+CDF_MEMORY_NOINLINE void operator delete[](void* block) noexcept { cdf::core::trackedFree(block); }
+
+CDF_MEMORY_NOINLINE void operator delete(void* block, std::size_t) noexcept { cdf::core::trackedFree(block); }
+
+CDF_MEMORY_NOINLINE void operator delete[](void* block, std::size_t) noexcept { cdf::core::trackedFree(block); }
+
+CDF_MEMORY_NOINLINE void operator delete(void* block, std::align_val_t) noexcept { cdf::core::trackedFree(block); }
+
+CDF_MEMORY_NOINLINE void operator delete[](void* block, std::align_val_t) noexcept { cdf::core::trackedFree(block); }
+
+CDF_MEMORY_NOINLINE void operator delete(void* block, std::size_t, std::align_val_t) noexcept {
+    cdf::core::trackedFree(block);
+}
+
+CDF_MEMORY_NOINLINE void operator delete[](void* block, std::size_t, std::align_val_t) noexcept {
+    cdf::core::trackedFree(block);
+}
+
+CDF_MEMORY_NOINLINE void operator delete(void* block, const std::nothrow_t&) noexcept {
+    cdf::core::trackedFree(block);
+}
+
+CDF_MEMORY_NOINLINE void operator delete[](void* block, const std::nothrow_t&) noexcept {
+    cdf::core::trackedFree(block);
+}
+
+#undef CDF_MEMORY_NOINLINE
+
+#endif
+
+#endif
@@ -0,0 +1,327 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cdf {
+
+/**
+ * @brief How an operation may use the shared thread pool.
+ */
+enum class Execution {
+    Sequential, /**< Runs on the calling thread only */
+    Parallel    /**< Splits the rows into morsels processed by the thread pool, when there is more than one morsel */
+};
+
+/**
+ * @brief Parallel execution of DataFrame operations.
+ *
+ * Work is split into morsels, fixed ranges of rows. Morsel boundaries only depend on the number of rows, so results
+ * combined in morsel order are the same whatever the number of threads. Frames of a single morsel always run on the
+ * calling thread.
+ */
+namespace parallel {
+
+/**
+ * @class ThreadPool
+ * @brief A pool of worker threads with one task deque per worker.
+ *
+ * Workers take tasks from the back of their own deque and steal from the front of the other deques when theirs is
+ * empty. Tasks submitted from a worker go to its own deque, other submissions are spread round-robin. A thread
+ * waiting for tasks it submitted runs pending tasks meanwhile, so nested parallel loops cannot deadlock.
+ */
+class ThreadPool {
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> nextQueue{0};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    /**
+     * @brief Index of the worker running on the current thread, -1 outside of the pool
+     */
+    static long long& workerIndex() {
+        static thread_local long long index = -1;
+        return index;
+    }
+
+    bool popFrom(size_t queueIdx, bool back, std::function<void()>& task) {
+        Queue& queue = *queues[queueIdx];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        if (back) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        --pending;
+        return true;
+    }
+
+    void workerLoop(size_t index) {
+        workerIndex() = index;
+        while (true) {
+            if (runPendingTask()) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this] { return stopping || pending > 0; });
+            if (stopping && pending == 0) {
+                return;
+            }
+        }
+    }
+
+   public:
+    /**
+     * @brief Starts the worker threads.
+     *
+     * @param numWorkers The number of worker threads, 0 runs every task on the submitting thread.
+     */
+    explicit ThreadPool(size_t numWorkers) {
+        for (size_t i = 0; i < std::max<size_t>(numWorkers, 1); i++) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        for (size_t i = 0; i < numWorkers; i++) {
+            workers.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Runs the remaining tasks and joins the worker threads.
+     */
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Returns the number of worker threads.
+     */
+    size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Queues a task.
+     */
+    void submit(std::function<void()> task) {
+        long long self = workerIndex();
+        size_t queueIdx = self >= 0 ? self : nextQueue++ % queues.size();
+        {
+            std::lock_guard<std::mutex> lock(queues[queueIdx]->mutex);
+            queues[queueIdx]->tasks.push_back(std::move(task));
+        }
+        ++pending;
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wake.notify_one();
+    }
+
+    /**
+     * @brief Runs one pending task on the calling thread, its own deque first, then stealing from the others.
+     *
+     * @return false if no task was pending.
+     */
+    bool runPendingTask() {
+        std::function<void()> task;
+        long long self = workerIndex();
+        size_t start = self >= 0 ? self : 0;
+        if (self >= 0 && popFrom(start, true, task)) {
+            task();
+            return true;
+        }
+        for (size_t k = 0; k < queues.size(); k++) {
+            if (popFrom((start + k) % queues.size(), false, task)) {
+                task();
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Library-wide parallel settings.
+ */
+struct Settings {
+    size_t numThreads = std::max<size_t>(1, std::thread::hardware_concurrency()); /**< Threads including the caller */
+    size_t morselSize = 1 << 16;                                                    /**< Rows per morsel */
+    Execution execution = Execution::Parallel; /**< Policy used when an operation is not given one */
+    size_t readBlockSize = 1 << 20;            /**< Bytes per block read ahead by the CSV reader */
+};
+
+Settings& settings() {
+    static Settings current;
+    return current;
+}
+
+std::unique_ptr<ThreadPool>& poolSlot() {
+    static std::unique_ptr<ThreadPool> pool;
+    return pool;
+}
+
+/**
+ * @brief Returns the shared pool, started on first use with `numThreads - 1` workers (the caller is the last one).
+ */
+ThreadPool& pool() {
+    static std::mutex poolMutex;
+    std::lock_guard<std::mutex> lock(poolMutex);
+    std::unique_ptr<ThreadPool>& slot = poolSlot();
+    if (!slot) {
+        slot = std::make_unique<ThreadPool>(settings().numThreads - 1);
+    }
+    return *slot;
+}
+
+/**
+ * @brief Returns the number of morsels covering n rows.
+ */
+size_t morselCount(size_t n) { return (n + settings().morselSize - 1) / settings().morselSize; }
+
+/**
+ * @brief Runs task(i) for every i in [0, numTasks) on the calling thread and the pool workers.
+ *
+ * Tasks are handed out one at a time through a shared counter, so faster threads take more of them. The first
+ * exception thrown by a task stops the remaining ones and is rethrown on the calling thread.
+ */
+template <typename Task>
+void runTasks(size_t numTasks, const Task& task, Execution execution = settings().execution) {
+    ThreadPool& threads = pool();
+    if (execution == Execution::Sequential || numTasks <= 1 || threads.size() == 0) {
+        for (size_t i = 0; i < numTasks; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> finished{0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto drain = [&] {
+        for (size_t i; (i = next++) < numTasks;) {
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next = numTasks;
+            }
+        }
+    };
+
+    size_t helpers = std::min(threads.size(), numTasks - 1);
+    for (size_t h = 0; h < helpers; h++) {
+        threads.submit([&] {
+            drain();
+            ++finished;
+        });
+    }
+    drain();
+    while (finished < helpers) {
+        if (!threads.runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * @brief Calls body(morsel, begin, end) for every morsel of [0, n)
+ */
+template <typename Body>
+void forEachMorsel(size_t n, const Body& body, Execution execution = settings().execution) {
+    size_t morselSize = settings().morselSize;
+    runTasks(
+        morselCount(n), [&](size_t m) { body(m, m * morselSize, std::min(n, (m + 1) * morselSize)); }, execution);
+}
+
+/**
+ * @brief Reduces [0, n) morsel by morsel, partial results are combined in morsel order
+ *
+ * @param reduce Callable returning the partial result of a range (begin, end)
+ * @param combine Callable combining two partial results
+ */
+template <typename T, typename Reduce, typename Combine>
+T reduceMorsels(size_t n, T init, const Reduce& reduce, const Combine& combine,
+                Execution execution = settings().execution) {
+    std::vector<T> partials(morselCount(n), init);
+    forEachMorsel(
+        n, [&](size_t m, size_t begin, size_t end) { partials[m] = reduce(begin, end); }, execution);
+    T result = init;
+    for (auto& partial : partials) {
+        result = combine(result, partial);
+    }
+    return result;
+}
+
+}  // namespace parallel
+
+/**
+ * @brief Sets the number of threads used by parallel operations, the calling thread included.
+ *
+ * Restarts the shared pool, must not be called while a parallel operation runs.
+ *
+ * @param numThreads The number of threads, 1 runs everything on the calling thread.
+ */
+void set_num_threads(size_t numThreads) {
+    parallel::settings().numThreads = std::max<size_t>(1, numThreads);
+    parallel::poolSlot().reset();
+}
+
+/**
+ * @brief Returns the number of threads used by parallel operations.
+ */
+size_t get_num_threads() { return parallel::settings().numThreads; }
+
+/**
+ * @brief Sets the number of rows per morsel (default is 65536), smaller morsels balance better but cost more.
+ */
+void set_morsel_size(size_t morselSize) { parallel::settings().morselSize = std::max<size_t>(1, morselSize); }
+
+/**
+ * @brief Sets the number of bytes per block read ahead of the parsing by `io::read_csv` (default is 1 MiB).
+ */
+void set_read_block_size(size_t bytes) { parallel::settings().readBlockSize = std::max<size_t>(1, bytes); }
+
+/**
+ * @brief Sets the policy used by operations which are not given one (default is Execution::Parallel).
+ */
+void set_execution(Execution execution) { parallel::settings().execution = execution; }
+
+}  // namespace cdf
+
+#endif
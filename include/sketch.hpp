@@ -0,0 +1,815 @@
+#ifndef SKETCH_HPP
+#define SKETCH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "data.hpp"
+#include "dtypes.hpp"
+#include "utils.hpp"
+
+namespace cdf {
+
+/**
+ * @brief Bounded-memory, mergeable summaries of data streams.
+ *
+ * Every sketch can be updated value by value, with a whole `core::Series` or chunk after chunk, merged with a
+ * sketch of the same configuration and serialized into a byte string. Partial sketches built by parallel workers
+ * can therefore be shipped around and merged into one summary.
+ */
+namespace sketch {
+
+/**
+ * @brief Appends plain values into a byte string.
+ */
+class ByteWriter {
+    std::string buffer;
+
+   public:
+    template <typename T>
+    void write(const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        buffer.append(bytes, sizeof(T));
+    }
+
+    void writeTag(const char* tag) { buffer.append(tag, 4); }
+
+    void writeString(const std::string& value) {
+        write<uint64_t>(value.size());
+        buffer.append(value);
+    }
+
+    /**
+     * @brief Writes a variant value prefixed by its type tag
+     */
+    void writeValue(const _cdfVal& value) {
+        write<uint8_t>(static_cast<uint8_t>(value.index()));
+        if (std::holds_alternative<std::string>(value)) {
+            writeString(std::get<std::string>(value));
+        } else if (std::holds_alternative<int>(value)) {
+            write<int>(std::get<int>(value));
+        } else if (std::holds_alternative<double>(value)) {
+            write<double>(std::get<double>(value));
+        }
+    }
+
+    std::string str() const { return buffer; }
+};
+
+/**
+ * @brief Reads plain values back from a byte string written by `ByteWriter`.
+ *
+ * @throws std::invalid_argument if the byte string is shorter than expected.
+ */
+class ByteReader {
+    const std::string& buffer;
+    size_t offset = 0;
+
+   public:
+    ByteReader(const std::string& buffer) : buffer(buffer) {}
+
+    template <typename T>
+    T read() {
+        if (offset + sizeof(T) > buffer.size()) {
+            throw std::invalid_argument("[cdf][sketch] Serialized sketch is truncated!");
+        }
+        T value;
+        std::memcpy(&value, buffer.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    std::string readString() {
+        uint64_t length = read<uint64_t>();
+        if (offset + length > buffer.size()) {
+            throw std::invalid_argument("[cdf][sketch] Serialized sketch is truncated!");
+        }
+        std::string value = buffer.substr(offset, length);
+        offset += length;
+        return value;
+    }
+
+    /**
+     * @brief Returns the number of bytes left to read
+     */
+    size_t remaining() const { return buffer.size() - offset; }
+
+    _cdfVal readValue() {
+        switch (read<uint8_t>()) {
+            case 0:
+                return readString();
+            case 1:
+                return read<int>();
+            case 2:
+                return read<double>();
+            default:
+                return NaN();
+        }
+    }
+
+    /**
+     * @brief Checks the 4 byte tag written in front of every sketch
+     */
+    void expectTag(const char* tag) {
+        if (buffer.size() < offset + 4 || buffer.compare(offset, 4, tag) != 0) {
+            throw std::invalid_argument(std::string("[cdf][sketch] Expected a serialized ") + tag + " sketch!");
+        }
+        offset += 4;
+    }
+};
+
+/**
+ * @brief Converts a numeric variant value to double
+ *
+ * @param value The value to be converted
+ * @param out The converted value
+ * @returns false if the value is a nan-value
+ * @throws std::runtime_error if string type field is found
+ */
+bool numericValue(const _cdfVal& value, double& out) {
+    if (std::holds_alternative<int>(value)) {
+        out = static_cast<double>(std::get<int>(value));
+        return true;
+    } else if (std::holds_alternative<double>(value)) {
+        out = std::get<double>(value);
+        return true;
+    } else if (std::holds_alternative<NaN>(value)) {
+        return false;
+    }
+    throw std::runtime_error("String Data-Type isn't expected!");
+}
+
+/**
+ * @class TDigest
+ * @brief Approximate quantiles (median, percentiles) of a numeric stream.
+ *
+ * Implements the merging t-digest: values are buffered and periodically compressed into a sorted list of
+ * weighted centroids. The arcsine scale function keeps centroids small near the tails, so extreme quantiles stay
+ * accurate while memory is bounded by roughly `compression` centroids.
+ */
+class TDigest {
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    double compression;
+    mutable std::vector<Centroid> centroids;
+    mutable std::vector<Centroid> buffer;
+    double totalWeight = 0;
+    double minValue = std::numeric_limits<double>::infinity();
+    double maxValue = -std::numeric_limits<double>::infinity();
+
+    // Scale function k1 mapping a quantile to the centroid index space
+    double scale(double q) const { return compression / (4 * std::asin(1.0)) * std::asin(2 * q - 1); }
+
+    /**
+     * @brief Merges the buffered values into the centroid list
+     */
+    void compress() const {
+        if (buffer.empty()) {
+            return;
+        }
+
+        std::vector<Centroid> all;
+        all.reserve(centroids.size() + buffer.size());
+        all.insert(all.end(), centroids.begin(), centroids.end());
+        all.insert(all.end(), buffer.begin(), buffer.end());
+        std::sort(all.begin(), all.end(), [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+
+        std::vector<Centroid> merged;
+        Centroid current = all[0];
+        double weightSoFar = 0;
+        for (size_t i = 1; i < all.size(); i++) {
+            double q0 = weightSoFar / totalWeight;
+            double q2 = (weightSoFar + current.weight + all[i].weight) / totalWeight;
+            if (scale(q2) - scale(q0) <= 1) {
+                current.weight += all[i].weight;
+                current.mean += (all[i].mean - current.mean) * all[i].weight / current.weight;
+            } else {
+                weightSoFar += current.weight;
+                merged.push_back(current);
+                current = all[i];
+            }
+        }
+        merged.push_back(current);
+
+        centroids.swap(merged);
+        buffer.clear();
+    }
+
+   public:
+    /**
+     * @brief Constructs an empty digest.
+     *
+     * @param compression Accuracy/memory trade-off, the digest keeps roughly this many centroids (default is 100).
+     */
+    TDigest(double compression = 100) : compression(compression) {
+        if (compression < 10) {
+            throw std::invalid_argument("[cdf][sketch] TDigest compression should be at least 10");
+        }
+    }
+
+    /**
+     * @brief Adds a value to the digest.
+     *
+     * @param value The value to add.
+     * @param weight The weight of the value (default is 1).
+     */
+    void add(double value, double weight = 1) {
+        if (std::isnan(value) || weight <= 0) {
+            return;
+        }
+        buffer.push_back({value, weight});
+        totalWeight += weight;
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+        if (buffer.size() >= static_cast<size_t>(compression * 5)) {
+            compress();
+        }
+    }
+
+    /**
+     * @brief Adds a variant value to the digest, ignores nan-values
+     *
+     * @throws std::runtime_error if string type field is found
+     */
+    void update(const _cdfVal& value) {
+        double numeric;
+        if (numericValue(value, numeric)) {
+            add(numeric);
+        }
+    }
+
+    /**
+     * @brief Adds every value of a series (or a chunk of a larger column) to the digest, ignores nan-values
+     *
+     * @throws std::runtime_error if string type field is found
+     */
+    void update(const core::Series& series) {
+        for (auto& value : series) {
+            update(value);
+        }
+    }
+
+    /**
+     * @brief Merges another digest into this one.
+     *
+     * @param other The digest to merge, typically built over another chunk of the same column.
+     */
+    void merge(const TDigest& other) {
+        other.compress();
+        for (auto& centroid : other.centroids) {
+            buffer.push_back(centroid);
+        }
+        totalWeight += other.totalWeight;
+        minValue = std::min(minValue, other.minValue);
+        maxValue = std::max(maxValue, other.maxValue);
+        compress();
+    }
+
+    /**
+     * @brief Returns the number of (weighted) values added to the digest.
+     */
+    double count() const { return totalWeight; }
+
+    /**
+     * @brief Estimates the value at the given quantile.
+     *
+     * @param q The quantile, between 0 and 1 (0.5 gives the median).
+     * @return The estimated value, or NaN if the digest is empty.
+     * @throws std::invalid_argument if q is outside [0, 1].
+     */
+    double quantile(double q) const {
+        if (q < 0 || q > 1) {
+            throw std::invalid_argument("[cdf][sketch] Quantile should be in [0, 1]");
+        }
+        compress();
+        if (centroids.empty()) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        if (centroids.size() == 1) {
+            return centroids[0].mean;
+        }
+
+        double index = q * totalWeight;
+        if (index < centroids[0].weight / 2) {
+            return minValue + (centroids[0].mean - minValue) * index / (centroids[0].weight / 2);
+        }
+
+        double weightSoFar = 0;
+        for (size_t i = 0; i + 1 < centroids.size(); i++) {
+            double leftCenter = weightSoFar + centroids[i].weight / 2;
+            double rightCenter = weightSoFar + centroids[i].weight + centroids[i + 1].weight / 2;
+            if (index <= rightCenter) {
+                double fraction = (index - leftCenter) / (rightCenter - leftCenter);
+                return centroids[i].mean + fraction * (centroids[i + 1].mean - centroids[i].mean);
+            }
+            weightSoFar += centroids[i].weight;
+        }
+
+        const Centroid& last = centroids.back();
+        double lastCenter = totalWeight - last.weight / 2;
+        double fraction = (index - lastCenter) / (last.weight / 2);
+        return last.mean + std::min(1.0, fraction) * (maxValue - last.mean);
+    }
+
+    /**
+     * @brief Serializes the digest into a byte string.
+     */
+    std::string serialize() const {
+        compress();
+        ByteWriter writer;
+        writer.writeTag("CTDG");
+        writer.write<double>(compression);
+        writer.write<double>(totalWeight);
+        writer.write<double>(minValue);
+        writer.write<double>(maxValue);
+        writer.write<uint64_t>(centroids.size());
+        for (auto& centroid : centroids) {
+            writer.write<double>(centroid.mean);
+            writer.write<double>(centroid.weight);
+        }
+        return writer.str();
+    }
+
+    /**
+     * @brief Restores a digest from a byte string produced by `serialize()`.
+     *
+     * @throws std::invalid_argument if the byte string is not a serialized TDigest.
+     */
+    static TDigest deserialize(const std::string& bytes) {
+        ByteReader reader(bytes);
+        reader.expectTag("CTDG");
+        TDigest digest(reader.read<double>());
+        digest.totalWeight = reader.read<double>();
+        digest.minValue = reader.read<double>();
+        digest.maxValue = reader.read<double>();
+        uint64_t numCentroids = reader.read<uint64_t>();
+        for (uint64_t i = 0; i < numCentroids; i++) {
+            double mean = reader.read<double>();
+            double weight = reader.read<double>();
+            digest.centroids.push_back({mean, weight});
+        }
+        return digest;
+    }
+};
+
+/**
+ * @class HyperLogLog
+ * @brief Approximate count of distinct values.
+ *
+ * Uses `2^precision` one-byte registers, the relative error is about `1.04 / sqrt(2^precision)` (0.8% for the
+ * default precision of 14, which takes 16KB).
+ */
+class HyperLogLog {
+    int precision;
+    std::vector<uint8_t> registers;
+
+   public:
+    /**
+     * @brief Constructs an empty HyperLogLog sketch.
+     *
+     * @param precision Number of index bits, between 4 and 18 (default is 14).
+     * @throws std::invalid_argument if precision is out of range.
+     */
+    HyperLogLog(int precision = 14) : precision(precision) {
+        if (precision < 4 || precision > 18) {
+            throw std::invalid_argument("[cdf][sketch] HyperLogLog precision should be in [4, 18]");
+        }
+        registers.assign(size_t(1) << precision, 0);
+    }
+
+    /**
+     * @brief Adds a pre-computed 64-bit hash to the sketch.
+     */
+    void addHash(uint64_t hash) {
+        size_t index = hash >> (64 - precision);
+        uint64_t remaining = (hash << precision) | (uint64_t(1) << (precision - 1));
+        uint8_t rank = 1;
+        while (!(remaining & (uint64_t(1) << 63))) {
+            remaining <<= 1;
+            ++rank;
+        }
+        registers[index] = std::max(registers[index], rank);
+    }
+
+    /**
+     * @brief Adds a variant value to the sketch, ignores nan-values
+     */
+    void update(const _cdfVal& value) {
+        if (!std::holds_alternative<NaN>(value)) {
+            addHash(hashValue(value));
+        }
+    }
+
+    /**
+     * @brief Adds every value of a series (or a chunk of a larger column) to the sketch, ignores nan-values
+     */
+    void update(const core::Series& series) {
+        for (auto& value : series) {
+            update(value);
+        }
+    }
+
+    /**
+     * @brief Merges another sketch into this one.
+     *
+     * @throws std::invalid_argument if the sketches have different precisions.
+     */
+    void merge(const HyperLogLog& other) {
+        if (other.precision != precision) {
+            throw std::invalid_argument("[cdf][sketch] Cannot merge HyperLogLog sketches of different precision");
+        }
+        for (size_t i = 0; i < registers.size(); i++) {
+            registers[i] = std::max(registers[i], other.registers[i]);
+        }
+    }
+
+    /**
+     * @brief Estimates the number of distinct values added to the sketch.
+     */
+    double estimate() const {
+        double m = static_cast<double>(registers.size());
+        double harmonicSum = 0;
+        int zeros = 0;
+        for (auto reg : registers) {
+            harmonicSum += std::ldexp(1.0, -reg);
+            zeros += (reg == 0);
+        }
+        double alpha = 0.7213 / (1 + 1.079 / m);
+        double estimate = alpha * m * m / harmonicSum;
+
+        // Linear counting is more accurate for small cardinalities
+        if (estimate <= 2.5 * m && zeros > 0) {
+            estimate = m * std::log(m / zeros);
+        }
+        return estimate;
+    }
+
+    /**
+     * @brief Serializes the sketch into a byte string.
+     */
+    std::string serialize() const {
+        ByteWriter writer;
+        writer.writeTag("CHLL");
+        writer.write<uint8_t>(static_cast<uint8_t>(precision));
+        for (auto reg : registers) {
+            writer.write<uint8_t>(reg);
+        }
+        return writer.str();
+    }
+
+    /**
+     * @brief Restores a sketch from a byte string produced by `serialize()`.
+     *
+     * @throws std::invalid_argument if the byte string is not a serialized HyperLogLog.
+     */
+    static HyperLogLog deserialize(const std::string& bytes) {
+        ByteReader reader(bytes);
+        reader.expectTag("CHLL");
+        HyperLogLog hll(reader.read<uint8_t>());
+        for (auto& reg : hll.registers) {
+            reg = reader.read<uint8_t>();
+        }
+        return hll;
+    }
+};
+
+/**
+ * @class HeavyHitters
+ * @brief Approximate top-k most frequent values (Space-Saving algorithm).
+ *
+ * Keeps at most `capacity` counters. When a new value arrives and all counters are taken, the counter with the
+ * smallest count is reassigned to it, and the evicted count is kept as the error bound of the new value. Every
+ * value with a true frequency above `n / capacity` is guaranteed to be present.
+ */
+class HeavyHitters {
+   public:
+    /**
+     * @brief A tracked value with its estimated count and the maximum overestimation of that count.
+     */
+    struct Entry {
+        _cdfVal value;
+        uint64_t count;
+        uint64_t error;
+    };
+
+   private:
+    struct ValueHash {
+        size_t operator()(const _cdfVal& value) const { return hashValue(value); }
+    };
+    struct ValueEqual {
+        bool operator()(const _cdfVal& lhs, const _cdfVal& rhs) const { return valueEquals(lhs, rhs); }
+    };
+
+    size_t capacity;
+    std::vector<Entry> entries;
+    std::unordered_map<_cdfVal, size_t, ValueHash, ValueEqual> slots;
+    uint64_t total = 0;
+
+    size_t minimumSlot() const {
+        size_t minSlot = 0;
+        for (size_t i = 1; i < entries.size(); i++) {
+            if (entries[i].count < entries[minSlot].count) {
+                minSlot = i;
+            }
+        }
+        return minSlot;
+    }
+
+   public:
+    /**
+     * @brief Constructs an empty summary.
+     *
+     * @param capacity Number of counters to keep (default is 64).
+     */
+    HeavyHitters(size_t capacity = 64) : capacity(capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("[cdf][sketch] HeavyHitters capacity should be positive");
+        }
+        entries.reserve(capacity);
+    }
+
+    /**
+     * @brief Adds a variant value to the summary, ignores nan-values and NaN doubles
+     *
+     * @param value The value to add.
+     * @param count The number of occurrences to add (default is 1).
+     */
+    void update(const _cdfVal& value, uint64_t count = 1) {
+        // A NaN double could not find its counter back, NaN != NaN
+        if (isMissing(value)) {
+            return;
+        }
+        total += count;
+
+        auto it = slots.find(value);
+        if (it != slots.end()) {
+            entries[it->second].count += count;
+        } else if (entries.size() < capacity) {
+            slots[value] = entries.size();
+            entries.push_back({value, count, 0});
+        } else {
+            size_t slot = minimumSlot();
+            slots.erase(entries[slot].value);
+            uint64_t evictedCount = entries[slot].count;
+            entries[slot] = {value, evictedCount + count, evictedCount};
+            slots[value] = slot;
+        }
+    }
+
+    /**
+     * @brief Adds every value of a series (or a chunk of a larger column) to the summary, ignores nan-values
+     */
+    void update(const core::Series& series) {
+        for (auto& value : series) {
+            update(value);
+        }
+    }
+
+    /**
+     * @brief Merges another summary into this one.
+     *
+     * Values missing from one of the full summaries could have occurred up to its minimum count, that count is added
+     * to their error bound before keeping the `capacity` largest counters.
+     *
+     * @throws std::invalid_argument if the summaries have different capacities.
+     */
+    void merge(const HeavyHitters& other) {
+        if (other.capacity != capacity) {
+            throw std::invalid_argument("[cdf][sketch] Cannot merge HeavyHitters of different capacities");
+        }
+        uint64_t thisMin = entries.size() == capacity ? entries[minimumSlot()].count : 0;
+        uint64_t otherMin = other.entries.size() == other.capacity ? other.entries[other.minimumSlot()].count : 0;
+
+        std::vector<Entry> combined = entries;
+        for (auto& entry : combined) {
+            auto it = other.slots.find(entry.value);
+            if (it != other.slots.end()) {
+                entry.count += other.entries[it->second].count;
+                entry.error += other.entries[it->second].error;
+            } else {
+                entry.count += otherMin;
+                entry.error += otherMin;
+            }
+        }
+        for (auto& entry : other.entries) {
+            if (slots.find(entry.value) == slots.end()) {
+                combined.push_back({entry.value, entry.count + thisMin, entry.error + thisMin});
+            }
+        }
+
+        std::sort(combined.begin(), combined.end(),
+                  [](const Entry& a, const Entry& b) { return a.count > b.count; });
+        if (combined.size() > capacity) {
+            combined.resize(capacity);
+        }
+
+        entries.swap(combined);
+        slots.clear();
+        for (size_t i = 0; i < entries.size(); i++) {
+            slots[entries[i].value] = i;
+        }
+        total += other.total;
+    }
+
+    /**
+     * @brief Returns the number of values added to the summary.
+     */
+    uint64_t count() const { return total; }
+
+    /**
+     * @brief Returns the k most frequent values in descending order of their estimated count.
+     *
+     * @param k The number of values to return (default is all tracked values).
+     */
+    std::vector<Entry> top(size_t k = std::numeric_limits<size_t>::max()) const {
+        std::vector<Entry> result = entries;
+        std::sort(result.begin(), result.end(), [](const Entry& a, const Entry& b) { return a.count > b.count; });
+        if (result.size() > k) {
+            result.resize(k);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Serializes the summary into a byte string.
+     */
+    std::string serialize() const {
+        ByteWriter writer;
+        writer.writeTag("CSSV");
+        writer.write<uint64_t>(capacity);
+        writer.write<uint64_t>(total);
+        writer.write<uint64_t>(entries.size());
+        for (auto& entry : entries) {
+            writer.writeValue(entry.value);
+            writer.write<uint64_t>(entry.count);
+            writer.write<uint64_t>(entry.error);
+        }
+        return writer.str();
+    }
+
+    /**
+     * @brief Restores a summary from a byte string produced by `serialize()`.
+     *
+     * @throws std::invalid_argument if the byte string is not a serialized HeavyHitters summary.
+     */
+    static HeavyHitters deserialize(const std::string& bytes) {
+        ByteReader reader(bytes);
+        reader.expectTag("CSSV");
+        uint64_t capacity = reader.read<uint64_t>();
+        uint64_t total = reader.read<uint64_t>();
+        uint64_t numEntries = reader.read<uint64_t>();
+        if (capacity == 0) {
+            throw std::invalid_argument("[cdf][sketch] HeavyHitters capacity should be positive");
+        }
+        if (numEntries > capacity) {
+            throw std::invalid_argument("[cdf][sketch] Serialized HeavyHitters holds more entries than its capacity!");
+        }
+        // Every entry takes at least 17 bytes: a type tag and two counts
+        if (numEntries > reader.remaining() / 17) {
+            throw std::invalid_argument("[cdf][sketch] Serialized sketch is truncated!");
+        }
+        // The capacity comes from the byte string, only the entries it holds are allocated
+        HeavyHitters summary(1);
+        summary.capacity = capacity;
+        summary.total = total;
+        summary.entries.reserve(numEntries);
+        for (uint64_t i = 0; i < numEntries; i++) {
+            _cdfVal value = reader.readValue();
+            uint64_t count = reader.read<uint64_t>();
+            uint64_t error = reader.read<uint64_t>();
+            if (!summary.slots.emplace(value, summary.entries.size()).second) {
+                throw std::invalid_argument("[cdf][sketch] Serialized HeavyHitters holds a value twice!");
+            }
+            summary.entries.push_back({value, count, error});
+        }
+        return summary;
+    }
+};
+
+/**
+ * @class CountMinSketch
+ * @brief Approximate frequency of any value in fixed memory.
+ *
+ * Estimates never undercount, and overcount by at most `e * n / width` with probability `1 - exp(-depth)`.
+ */
+class CountMinSketch {
+    size_t width, depth;
+    std::vector<uint64_t> table;
+
+    size_t cell(size_t row, uint64_t hash) const {
+        return row * width + mixHash(hash + row * 0x9e3779b97f4a7c15ULL) % width;
+    }
+
+   public:
+    /**
+     * @brief Constructs an empty sketch.
+     *
+     * @param width Number of counters per row (default is 2048).
+     * @param depth Number of rows / hash functions (default is 5).
+     */
+    CountMinSketch(size_t width = 2048, size_t depth = 5) : width(width), depth(depth) {
+        if (width == 0 || depth == 0) {
+            throw std::invalid_argument("[cdf][sketch] CountMinSketch dimensions should be positive");
+        }
+        table.assign(width * depth, 0);
+    }
+
+    /**
+     * @brief Adds a variant value to the sketch, ignores nan-values
+     */
+    void update(const _cdfVal& value, uint64_t count = 1) {
+        if (std::holds_alternative<NaN>(value)) {
+            return;
+        }
+        uint64_t hash = hashValue(value);
+        for (size_t row = 0; row < depth; row++) {
+            table[cell(row, hash)] += count;
+        }
+    }
+
+    /**
+     * @brief Adds every value of a series (or a chunk of a larger column) to the sketch, ignores nan-values
+     */
+    void update(const core::Series& series) {
+        for (auto& value : series) {
+            update(value);
+        }
+    }
+
+    /**
+     * @brief Estimates how many times a value was added.
+     */
+    uint64_t estimate(const _cdfVal& value) const {
+        uint64_t hash = hashValue(value);
+        uint64_t result = std::numeric_limits<uint64_t>::max();
+        for (size_t row = 0; row < depth; row++) {
+            result = std::min(result, table[cell(row, hash)]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Merges another sketch into this one.
+     *
+     * @throws std::invalid_argument if the sketches have different dimensions.
+     */
+    void merge(const CountMinSketch& other) {
+        if (other.width != width || other.depth != depth) {
+            throw std::invalid_argument("[cdf][sketch] Cannot merge CountMinSketch of different dimensions");
+        }
+        for (size_t i = 0; i < table.size(); i++) {
+            table[i] += other.table[i];
+        }
+    }
+
+    /**
+     * @brief Serializes the sketch into a byte string.
+     */
+    std::string serialize() const {
+        ByteWriter writer;
+        writer.writeTag("CCMS");
+        writer.write<uint64_t>(width);
+        writer.write<uint64_t>(depth);
+        for (auto counter : table) {
+            writer.write<uint64_t>(counter);
+        }
+        return writer.str();
+    }
+
+    /**
+     * @brief Restores a sketch from a byte string produced by `serialize()`.
+     *
+     * @throws std::invalid_argument if the byte string is not a serialized CountMinSketch.
+     */
+    static CountMinSketch deserialize(const std::string& bytes) {
+        ByteReader reader(bytes);
+        reader.expectTag("CCMS");
+        size_t width = reader.read<uint64_t>();
+        size_t depth = reader.read<uint64_t>();
+        // Checked before allocating the table, without computing width * depth which may overflow
+        if (depth != 0 && width > reader.remaining() / sizeof(uint64_t) / depth) {
+            throw std::invalid_argument("[cdf][sketch] Serialized sketch is truncated!");
+        }
+        CountMinSketch sketch(width, depth);
+        for (auto& counter : sketch.table) {
+            counter = reader.read<uint64_t>();
+        }
+        return sketch;
+    }
+};
+
+}  // namespace sketch
+
+}  // namespace cdf
+
+#endif
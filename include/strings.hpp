@@ -0,0 +1,223 @@
+#ifndef STRINGS_HPP
+#define STRINGS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "dtypes.hpp"
+
+namespace cdf {
+
+namespace core {
+
+/**
+ * @brief 16-byte header of a string cell.
+ *
+ * Strings of up to 12 bytes are stored entirely in the header, zero padded. Longer strings keep their first 4 bytes
+ * in the header followed by the offset of the whole string in the column arena. Comparing the first 8 bytes of two
+ * headers (length and prefix) settles most equality tests without touching the arena.
+ */
+struct StringHeader {
+    uint32_t length = 0;
+    char bytes[12] = {0}; /**< Whole string when it fits, else a 4-byte prefix and a 64-bit arena offset */
+
+    uint64_t lengthAndPrefix() const {
+        uint64_t word;
+        std::memcpy(&word, this, sizeof(word));
+        return word;
+    }
+
+    uint64_t payload() const {
+        uint64_t word;
+        std::memcpy(&word, bytes + 4, sizeof(word));
+        return word;
+    }
+};
+
+static_assert(sizeof(StringHeader) == 16, "String headers are expected to be 16 bytes");
+
+/**
+ * @class StringColumn
+ * @brief String values stored as fixed-size headers plus one byte arena per column.
+ *
+ * Long strings are appended to a single arena instead of being allocated one by one. Comparisons against a constant
+ * start from the headers: equality first checks length and prefix, ordering first compares the prefixes.
+ */
+class StringColumn {
+    std::vector<StringHeader> headers;
+    std::vector<char> arena;
+    std::vector<uint8_t> validity; /**< 1 for a string, 0 for a nan-value */
+
+   public:
+    static constexpr size_t inlineLength = 12;
+    static constexpr size_t prefixLength = 4;
+
+    /**
+     * @brief Builds the header of a string, long strings get the given arena offset.
+     */
+    static StringHeader makeHeader(std::string_view value, uint64_t offset = 0) {
+        StringHeader header;
+        header.length = value.size();
+        if (value.size() <= inlineLength) {
+            std::memcpy(header.bytes, value.data(), value.size());
+        } else {
+            std::memcpy(header.bytes, value.data(), prefixLength);
+            std::memcpy(header.bytes + prefixLength, &offset, sizeof(offset));
+        }
+        return header;
+    }
+
+    /**
+     * @brief Makes room for a number of values and of arena bytes.
+     */
+    void reserve(size_t values, size_t bytes = 0) {
+        headers.reserve(values);
+        validity.reserve(values);
+        arena.reserve(bytes);
+    }
+
+    /**
+     * @brief Appends a string.
+     */
+    void append(std::string_view value) {
+        headers.push_back(makeHeader(value, arena.size()));
+        if (value.size() > inlineLength) {
+            arena.insert(arena.end(), value.begin(), value.end());
+        }
+        validity.push_back(1);
+    }
+
+    /**
+     * @brief Appends a nan-value.
+     */
+    void appendNull() {
+        headers.push_back(StringHeader());
+        validity.push_back(0);
+    }
+
+    /**
+     * @brief Returns the number of values, including nan-values.
+     */
+    size_t size() const { return headers.size(); }
+
+    /**
+     * @brief Returns whether the value at an index is a string (not a nan-value).
+     */
+    bool isValid(size_t index) const { return validity[index] != 0; }
+
+    /**
+     * @brief Returns the string at an index, empty for nan-values.
+     */
+    std::string_view view(size_t index) const {
+        const StringHeader& header = headers[index];
+        if (header.length <= inlineLength) {
+            return std::string_view(header.bytes, header.length);
+        }
+        return std::string_view(arena.data() + header.payload(), header.length);
+    }
+
+    /**
+     * @brief Tests the string at an index for equality with a probe built by `makeHeader(value)`.
+     */
+    bool equals(size_t index, const StringHeader& probe, std::string_view value) const {
+        const StringHeader& header = headers[index];
+        if (header.lengthAndPrefix() != probe.lengthAndPrefix()) {
+            return false;
+        }
+        if (header.length <= inlineLength) {
+            return header.payload() == probe.payload();
+        }
+        return std::memcmp(arena.data() + header.payload() + prefixLength, value.data() + prefixLength,
+                           header.length - prefixLength) == 0;
+    }
+
+    /**
+     * @brief Three-way comparison of the string at an index with a probe built by `makeHeader(value)`.
+     *
+     * @return A negative number, zero or a positive number when the string orders before, equal or after the value.
+     */
+    int compare(size_t index, const StringHeader& probe, std::string_view value) const {
+        const StringHeader& header = headers[index];
+        size_t common = std::min<size_t>(prefixLength, std::min(header.length, probe.length));
+        int prefixOrder = std::memcmp(header.bytes, probe.bytes, common);
+        if (prefixOrder != 0) {
+            return prefixOrder;
+        }
+        return view(index).compare(value);
+    }
+
+    /**
+     * @brief Returns the number of bytes held by the headers and the arena.
+     */
+    size_t memoryBytes() const {
+        return headers.capacity() * sizeof(StringHeader) + arena.capacity() + validity.capacity();
+    }
+};
+
+/**
+ * @brief Builds the compact representation of a column holding strings and nan-values
+ *
+ * @param values The variant values
+ * @returns The string column
+ * @throws std::runtime_error if a numeric field is found
+ */
+StringColumn toStringColumn(const std::vector<_cdfVal>& values) {
+    size_t arenaBytes = 0;
+    for (auto& value : values) {
+        if (std::holds_alternative<std::string>(value)) {
+            size_t length = std::get<std::string>(value).size();
+            arenaBytes += length > StringColumn::inlineLength ? length : 0;
+        } else if (!std::holds_alternative<NaN>(value)) {
+            throw std::runtime_error("Numeric Data-Type isn't expected!");
+        }
+    }
+
+    StringColumn column;
+    column.reserve(values.size(), arenaBytes);
+    for (auto& value : values) {
+        if (std::holds_alternative<std::string>(value)) {
+            column.append(std::get<std::string>(value));
+        } else {
+            column.appendNull();
+        }
+    }
+    return column;
+}
+
+/**
+ * @brief Compares every string of a column with a value, nan-values compare false
+ *
+ * Equality and inequality go through the header fast path, the other comparators through the prefix-first three-way
+ * comparison.
+ *
+ * @param flags Receives 1 where the comparison holds, for the indices in [begin, end)
+ */
+template <typename Comparator>
+void compareStrings(const StringColumn& column, const std::string& value, const Comparator& op, uint8_t* flags,
+                    size_t begin, size_t end) {
+    StringHeader probe = StringColumn::makeHeader(value);
+    for (size_t i = begin; i < end; i++) {
+        if (!column.isValid(i)) {
+            flags[i] = 0;
+        } else if constexpr (std::is_same_v<Comparator, std::equal_to<>>) {
+            flags[i] = column.equals(i, probe, value);
+        } else if constexpr (std::is_same_v<Comparator, std::not_equal_to<>>) {
+            flags[i] = !column.equals(i, probe, value);
+        } else {
+            flags[i] = op(column.compare(i, probe, value), 0);
+        }
+    }
+}
+
+}  // namespace core
+
+}  // namespace cdf
+
+#endif
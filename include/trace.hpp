@@ -0,0 +1,351 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cdf {
+
+/**
+ * @brief Tracing of the operations of the library.
+ *
+ * Public operations open a span (category "op") and some of them a span per internal phase (category "phase").
+ * A span records its wall time, the rows it read and produced, and the bytes allocated by its thread while it was
+ * open. Tracing is off until `trace::enable()` is called, a disabled span costs one relaxed atomic load. Defining
+ * `CDF_DISABLE_TRACING` before including cdf removes the spans entirely.
+ *
+ * Allocations are only counted when the tracking allocator is compiled in, see `cdf::memory_stats`
+ * (`CDF_TRACK_MEMORY`, or its alias `CDF_TRACE_ALLOCATIONS`).
+ *
+ * Example:
+ * ```
+ * cdf::trace::enable();
+ * auto df = cdf::io::read_csv("data.csv");
+ * double mean = df[cdf::col("Age") > 30]["Fare"].mean();
+ * cdf::trace::write_chrome_trace("trace.json"); // open in chrome://tracing or ui.perfetto.dev
+ * cdf::trace::print_summary();
+ * ```
+ */
+namespace trace {
+
+/**
+ * @brief A finished span
+ */
+struct Event {
+    std::string name;
+    std::string category;
+    size_t thread;          /**< Small per-process thread number, 0 for the first thread tracing */
+    int64_t startNs;        /**< Start time relative to the last `enable()` or `clear()` */
+    int64_t durationNs;
+    size_t rowsIn;
+    size_t rowsOut;
+    size_t bytesAllocated;  /**< Bytes allocated by the thread of the span, 0 without CDF_TRACK_MEMORY */
+    size_t allocations;
+};
+
+/**
+ * @brief Aggregated spans of one operation
+ */
+struct OpSummary {
+    std::string name;
+    size_t calls = 0;
+    int64_t totalNs = 0;
+    int64_t maxNs = 0;
+    size_t rowsIn = 0;
+    size_t rowsOut = 0;
+    size_t bytesAllocated = 0;
+    size_t allocations = 0;
+};
+
+/**
+ * @brief Allocations made by one thread since it started
+ */
+struct AllocationCounters {
+    size_t bytes = 0;
+    size_t count = 0;
+};
+
+AllocationCounters& threadAllocations() {
+    static thread_local AllocationCounters counters;
+    return counters;
+}
+
+/**
+ * @brief Recorded events, shared by every thread
+ */
+class Recorder {
+    std::mutex mutex;
+    std::vector<Event> events;
+    size_t dropped = 0;
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+   public:
+    std::atomic<bool> enabled{false};
+    size_t maxEvents = 1 << 20; /**< Events beyond this count are dropped */
+
+    int64_t now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    void record(Event&& event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (events.size() < maxEvents) {
+            events.push_back(std::move(event));
+        } else {
+            dropped++;
+        }
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.clear();
+        dropped = 0;
+        epoch = std::chrono::steady_clock::now();
+    }
+
+    std::vector<Event> snapshot() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return events;
+    }
+
+    size_t droppedEvents() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return dropped;
+    }
+};
+
+Recorder& recorder() {
+    static Recorder instance;
+    return instance;
+}
+
+/**
+ * @brief Number of the current thread in the trace
+ */
+size_t threadNumber() {
+    static std::atomic<size_t> nextThread{0};
+    static thread_local size_t number = nextThread++;
+    return number;
+}
+
+/**
+ * @class Span
+ * @brief Records the time, rows and allocations of a scope when tracing is enabled.
+ */
+class Span {
+    const char* name;
+    const char* category;
+    bool active;
+    int64_t start = 0;
+    AllocationCounters allocationsAtStart;
+    size_t in = 0;
+    size_t out = 0;
+
+   public:
+    explicit Span(const char* name, const char* category = "op")
+        : name(name), category(category), active(recorder().enabled.load(std::memory_order_relaxed)) {
+        if (active) {
+            allocationsAtStart = threadAllocations();
+            start = recorder().now();
+        }
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    ~Span() { end(); }
+
+    /**
+     * @brief Closes the span before the end of its scope, used for consecutive phases of one function.
+     */
+    void end() {
+        if (!active) {
+            return;
+        }
+        active = false;
+        int64_t finish = recorder().now();
+        const AllocationCounters& allocations = threadAllocations();
+        recorder().record(Event{name, category, threadNumber(), start, finish - start, in, out,
+                                allocations.bytes - allocationsAtStart.bytes,
+                                allocations.count - allocationsAtStart.count});
+    }
+
+    void rowsIn(size_t rows) { in = rows; }
+    void rowsOut(size_t rows) { out = rows; }
+};
+
+/**
+ * @brief Stands in for `Span` when tracing is compiled out
+ */
+struct NullSpan {
+    explicit NullSpan(const char*, const char* = "op") {}
+    void end() {}
+    void rowsIn(size_t) {}
+    void rowsOut(size_t) {}
+};
+
+/**
+ * @brief Starts recording spans, from a clean trace.
+ */
+void enable() {
+    recorder().clear();
+    recorder().enabled = true;
+}
+
+/**
+ * @brief Stops recording spans, recorded events are kept.
+ */
+void disable() { recorder().enabled = false; }
+
+/**
+ * @brief Returns whether spans are recorded.
+ */
+bool is_enabled() { return recorder().enabled; }
+
+/**
+ * @brief Drops the recorded events and restarts the trace clock.
+ */
+void clear() { recorder().clear(); }
+
+/**
+ * @brief Sets the number of events kept, later ones are dropped (default is 1048576).
+ */
+void set_max_events(size_t maxEvents) { recorder().maxEvents = maxEvents; }
+
+/**
+ * @brief Returns a copy of the recorded events.
+ */
+std::vector<Event> events() { return recorder().snapshot(); }
+
+/**
+ * @brief Writes a string as a JSON string literal
+ */
+void writeJsonString(std::ostream& out, const std::string& value) {
+    out << '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+/**
+ * @brief Writes the recorded events in the Chrome trace event format (complete events, times in microseconds).
+ *
+ * The output opens in chrome://tracing and ui.perfetto.dev, nested spans show up as a flame graph per thread.
+ */
+void write_chrome_trace(std::ostream& out) {
+    std::vector<Event> recorded = events();
+    out << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":" << recorder().droppedEvents()
+        << "},\"traceEvents\":[";
+    for (size_t i = 0; i < recorded.size(); i++) {
+        const Event& event = recorded[i];
+        out << (i ? ",\n" : "\n") << "{\"name\":";
+        writeJsonString(out, event.name);
+        out << ",\"cat\":";
+        writeJsonString(out, event.category);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread << std::fixed << std::setprecision(3)
+            << ",\"ts\":" << event.startNs / 1e3 << ",\"dur\":" << event.durationNs / 1e3
+            << std::defaultfloat << ",\"args\":{\"rows_in\":" << event.rowsIn << ",\"rows_out\":" << event.rowsOut
+            << ",\"bytes_allocated\":" << event.bytesAllocated << ",\"allocations\":" << event.allocations << "}}";
+    }
+    out << "\n]}\n";
+}
+
+/**
+ * @brief Writes the recorded events to a Chrome trace JSON file.
+ *
+ * @throws std::runtime_error if the file cannot be written
+ */
+void write_chrome_trace(const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("[cdf][trace] Unable to write " + path);
+    }
+    write_chrome_trace(file);
+}
+
+/**
+ * @brief Aggregates the recorded events by name, the slowest operations (total time) first.
+ */
+std::vector<OpSummary> summary() {
+    std::map<std::string, OpSummary> byName;
+    for (auto& event : events()) {
+        OpSummary& op = byName[event.name];
+        op.name = event.name;
+        op.calls++;
+        op.totalNs += event.durationNs;
+        op.maxNs = std::max(op.maxNs, event.durationNs);
+        op.rowsIn += event.rowsIn;
+        op.rowsOut += event.rowsOut;
+        op.bytesAllocated += event.bytesAllocated;
+        op.allocations += event.allocations;
+    }
+
+    std::vector<OpSummary> ops;
+    for (auto& [name, op] : byName) {
+        ops.push_back(op);
+    }
+    std::stable_sort(ops.begin(), ops.end(),
+                     [](const OpSummary& a, const OpSummary& b) { return a.totalNs > b.totalNs; });
+    return ops;
+}
+
+/**
+ * @brief Prints the per-operation summary as a table: calls, total/mean/max time, rows and allocations.
+ */
+void print_summary(std::ostream& out = std::cout) {
+    std::vector<OpSummary> ops = summary();
+    size_t nameWidth = 9;
+    for (auto& op : ops) {
+        nameWidth = std::max(nameWidth, op.name.size());
+    }
+
+    out << std::left << std::setw(nameWidth) << "operation" << std::right << std::setw(8) << "calls" << std::setw(12)
+        << "total ms" << std::setw(12) << "mean ms" << std::setw(12) << "max ms" << std::setw(14) << "rows in"
+        << std::setw(14) << "rows out" << std::setw(14) << "bytes" << std::setw(10) << "allocs" << "\n";
+    out << std::fixed << std::setprecision(3);
+    for (auto& op : ops) {
+        out << std::left << std::setw(nameWidth) << op.name << std::right << std::setw(8) << op.calls << std::setw(12)
+            << op.totalNs / 1e6 << std::setw(12) << op.totalNs / 1e6 / op.calls << std::setw(12) << op.maxNs / 1e6
+            << std::setw(14) << op.rowsIn << std::setw(14) << op.rowsOut << std::setw(14) << op.bytesAllocated
+            << std::setw(10) << op.allocations << "\n";
+    }
+    out << std::defaultfloat;
+}
+
+}  // namespace trace
+
+}  // namespace cdf
+
+/**
+ * @brief Opens a span named `name` until the end of the scope or `var.end()`, `var.rowsIn(n)` and `var.rowsOut(n)`
+ * record rows.
+ */
+#ifdef CDF_DISABLE_TRACING
+#define CDF_TRACE_SPAN(var, name) cdf::trace::NullSpan var(name)
+#define CDF_TRACE_PHASE(var, name) cdf::trace::NullSpan var(name)
+#else
+#define CDF_TRACE_SPAN(var, name) cdf::trace::Span var(name)
+#define CDF_TRACE_PHASE(var, name) cdf::trace::Span var(name, "phase")
+#endif
+
+#endif
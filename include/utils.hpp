@@ -1,7 +1,11 @@
 #ifndef UTILS_HPP
 #define UTILS_HPP
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 #include <vector>
 
@@ -145,4 +149,145 @@ std::string to_string(const T& value, int precision = 12) {
     return strAns;
 }
 
+/**
+ * @brief Finalizes a 64-bit value into a well distributed hash (splitmix64 finalizer)
+ *
+ * @param x Value to be mixed
+ * @returns Mixed 64-bit hash
+ */
+uint64_t mixHash(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * @brief Hashes a byte sequence (FNV-1a followed by a finalizer)
+ *
+ * @param bytes Pointer to the first byte
+ * @param length Number of bytes
+ * @returns 64-bit hash of the bytes
+ */
+uint64_t hashBytes(const char* bytes, size_t length) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; i++) {
+        h ^= static_cast<unsigned char>(bytes[i]);
+        h *= 0x100000001b3ULL;
+    }
+    return mixHash(h);
+}
+
+/**
+ * @brief Hashes a double through its bit pattern, folding -0.0 into 0.0 and every NaN into one NaN
+ *
+ * @param value The value to hash
+ * @returns 64-bit hash of the value
+ */
+uint64_t hashDouble(double value) {
+    if (value == 0.0) {
+        value = 0.0;
+    } else if (std::isnan(value)) {
+        value = std::numeric_limits<double>::quiet_NaN();
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return mixHash(bits);
+}
+
+/**
+ * @brief Hashes a variant value into a stable 64-bit hash
+ *
+ * Numeric values are hashed through their double representation, so `1` and `1.0` share a hash, matching the
+ * equality used by `valueEquals`. The hash does not depend on the process, so it can be used for data shared
+ * between workers.
+ *
+ * @param var a cdf::_cdfVal variant variable
+ * @returns 64-bit hash of the value
+ */
+uint64_t hashValue(const _cdfVal& var) {
+    return std::visit(
+        [](const auto& value) -> uint64_t {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, std::string>) {
+                return hashBytes(value.data(), value.size());
+            } else if constexpr (std::is_same_v<T, cdf::NaN>) {
+                return 0;
+            } else {
+                return hashDouble(static_cast<double>(value));
+            }
+        },
+        var);
+}
+
+/**
+ * @brief Checks whether a variant value is missing: a nan-value or a NaN double
+ *
+ * @param value The value to check
+ * @returns true for a nan-value or a NaN double
+ */
+bool isMissing(const _cdfVal& value) {
+    if (std::holds_alternative<cdf::NaN>(value)) {
+        return true;
+    }
+    return std::holds_alternative<double>(value) && std::isnan(std::get<double>(value));
+}
+
+/**
+ * @brief Checks equality of two variant values, treating int and double values numerically
+ *
+ * Like nan-values, NaN doubles are equal to each other, so duplicate rows holding them are found.
+ *
+ * @param lhs First value
+ * @param rhs Second value
+ * @returns true if both values represent the same value
+ */
+bool valueEquals(const _cdfVal& lhs, const _cdfVal& rhs) {
+    bool lhsNumeric = std::holds_alternative<int>(lhs) || std::holds_alternative<double>(lhs);
+    bool rhsNumeric = std::holds_alternative<int>(rhs) || std::holds_alternative<double>(rhs);
+    if (lhsNumeric && rhsNumeric) {
+        double l = std::holds_alternative<int>(lhs) ? std::get<int>(lhs) : std::get<double>(lhs);
+        double r = std::holds_alternative<int>(rhs) ? std::get<int>(rhs) : std::get<double>(rhs);
+        return l == r || (std::isnan(l) && std::isnan(r));
+    }
+    if (lhs.index() != rhs.index()) {
+        return false;
+    }
+    if (std::holds_alternative<std::string>(lhs)) {
+        return std::get<std::string>(lhs) == std::get<std::string>(rhs);
+    }
+    return true;  // Both are cdf::NaN
+}
+
+/**
+ * @brief Orders two variant values: numbers (compared numerically) first, then strings, then nan-values
+ *
+ * @param lhs First value
+ * @param rhs Second value
+ * @returns true if lhs is ordered before rhs
+ */
+bool valueLess(const _cdfVal& lhs, const _cdfVal& rhs) {
+    auto rank = [](const _cdfVal& value) {
+        if (std::holds_alternative<int>(value) || std::holds_alternative<double>(value)) {
+            return 0;
+        }
+        return std::holds_alternative<std::string>(value) ? 1 : 2;
+    };
+    int lhsRank = rank(lhs), rhsRank = rank(rhs);
+    if (lhsRank != rhsRank) {
+        return lhsRank < rhsRank;
+    }
+    if (lhsRank == 0) {
+        double l = std::holds_alternative<int>(lhs) ? std::get<int>(lhs) : std::get<double>(lhs);
+        double r = std::holds_alternative<int>(rhs) ? std::get<int>(rhs) : std::get<double>(rhs);
+        return l < r;
+    }
+    if (lhsRank == 1) {
+        return std::get<std::string>(lhs) < std::get<std::string>(rhs);
+    }
+    return false;
+}
+
 #endif
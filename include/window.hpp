@@ -0,0 +1,378 @@
+#ifndef WINDOW_HPP
+#define WINDOW_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "kernels.hpp"
+#include "parallel.hpp"
+
+namespace cdf {
+
+namespace kernels {
+
+/**
+ * @brief Aggregate computed over a sliding window
+ */
+enum class WindowAgg { Count, Sum, Mean, Min, Max, Var };
+
+/**
+ * @brief Running sum of the values entering and leaving a window.
+ *
+ * Integers are summed exactly in 64 bits, doubles with Neumaier compensation so removing values does not accumulate
+ * rounding errors.
+ */
+template <typename Acc>
+class RunningSum {
+    Acc sum = 0;
+    Acc compensation = 0;
+
+    void addTerm(Acc term) {
+        if constexpr (std::is_integral_v<Acc>) {
+            sum += term;
+        } else {
+            Acc total = sum + term;
+            compensation += std::abs(sum) >= std::abs(term) ? (sum - total) + term : (term - total) + sum;
+            sum = total;
+        }
+    }
+
+   public:
+    template <typename T>
+    void add(const T* values, size_t row) {
+        addTerm(static_cast<Acc>(values[row]));
+    }
+    template <typename T>
+    void remove(const T* values, size_t row) {
+        addTerm(-static_cast<Acc>(values[row]));
+    }
+    Acc value() const { return sum + compensation; }
+};
+
+/**
+ * @brief Running mean and sum of squared deviations (Welford), values can leave the window.
+ *
+ * Removals leave rounding residues, so a window made of one repeated value, detected from the run of equal values
+ * ending the window, reports an exact 0.
+ */
+class RunningMoments {
+    size_t n = 0;
+    double mean = 0;
+    double squares = 0;
+    double last = 0;
+    size_t sameRun = 0; /**< Number of consecutive values equal to the last one */
+
+   public:
+    template <typename T>
+    void add(const T* values, size_t row) {
+        double value = static_cast<double>(values[row]);
+        sameRun = n > 0 && value == last ? sameRun + 1 : 1;
+        last = value;
+        n++;
+        double delta = value - mean;
+        mean += delta / n;
+        squares += delta * (value - mean);
+    }
+
+    template <typename T>
+    void remove(const T* values, size_t row) {
+        double value = static_cast<double>(values[row]);
+        if (--n == 0) {
+            mean = squares = 0;
+            return;
+        }
+        double delta = value - mean;
+        mean -= delta / n;
+        squares = std::max(0.0, squares - delta * (value - mean));
+    }
+
+    double variance(int ddof) const {
+        if (static_cast<long long>(n) <= ddof) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        return sameRun >= n ? 0.0 : squares / (n - ddof);
+    }
+};
+
+/**
+ * @brief Minimum (or maximum) of a sliding window, with a deque of candidate rows in increasing order of value
+ * (decreasing for the maximum). Every row enters and leaves the deque once.
+ */
+template <bool Greater>
+class RunningExtreme {
+    std::deque<size_t> candidates;
+
+   public:
+    template <typename T>
+    void add(const T* values, size_t row) {
+        while (!candidates.empty() &&
+               (Greater ? values[candidates.back()] <= values[row] : values[candidates.back()] >= values[row])) {
+            candidates.pop_back();
+        }
+        candidates.push_back(row);
+    }
+
+    template <typename T>
+    void remove(const T*, size_t row) {
+        if (!candidates.empty() && candidates.front() == row) {
+            candidates.pop_front();
+        }
+    }
+
+    size_t row() const { return candidates.front(); }
+};
+
+/**
+ * @brief A running aggregate fed with the rows of a window which hold a value, and their count
+ */
+template <typename T, typename Running>
+struct WindowState {
+    const T* values;
+    const uint8_t* validity;
+    Running running;
+    size_t count = 0;
+
+    WindowState(const T* values, const uint8_t* validity) : values(values), validity(validity) {}
+
+    bool holdsValue(size_t row) const { return validity[row] && values[row] == values[row]; }
+
+    void add(size_t row) {
+        if (holdsValue(row)) {
+            count++;
+            running.add(values, row);
+        }
+    }
+
+    void remove(size_t row) {
+        if (holdsValue(row)) {
+            count--;
+            running.remove(values, row);
+        }
+    }
+};
+
+/**
+ * @brief Calls `emit(i, state)` for every row i with the state of the window ending at i.
+ *
+ * Rows are processed morsel by morsel in parallel, each morsel first feeds the `window - 1` rows before it to a fresh
+ * state, so the cost does not depend on the window size. Windows of a morsel or more run as one sequential pass.
+ *
+ * @param makeState Returns a state with `add(row)` and `remove(row)`.
+ */
+template <typename MakeState, typename Emit>
+void slideWindow(size_t n, size_t window, const MakeState& makeState, const Emit& emit) {
+    size_t morselSize = parallel::settings().morselSize;
+    size_t blockRows = window >= morselSize ? std::max<size_t>(n, 1) : morselSize;
+    parallel::runTasks((n + blockRows - 1) / blockRows, [&](size_t block) {
+        size_t begin = block * blockRows;
+        size_t end = std::min(n, begin + blockRows);
+        size_t start = begin >= window - 1 ? begin - (window - 1) : 0;
+        auto state = makeState();
+        for (size_t i = start; i < end; i++) {
+            state.add(i);
+            if (i >= start + window) {
+                state.remove(i - window);
+            }
+            if (i >= begin) {
+                emit(i, state);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Computes an aggregate over the window of `window` rows ending at every row.
+ *
+ * Nan-values and NaN doubles are skipped, a window with fewer than `minPeriods` values gives a nan-value. Sums,
+ * minima and maxima of integer columns stay integral, counts are integers, means and variances doubles.
+ *
+ * @param window Rows per window, at least 1.
+ * @param minPeriods Minimum number of values in a window, at least 1.
+ * @param ddof Delta degrees of freedom of the variance.
+ */
+TypedColumn rollingAggregate(const TypedColumn& column, size_t window, size_t minPeriods, WindowAgg agg,
+                             int ddof = 1) {
+    size_t n = column.size();
+    TypedColumn result;
+    bool keepsType = agg == WindowAgg::Sum || agg == WindowAgg::Min || agg == WindowAgg::Max;
+    result.isInt = agg == WindowAgg::Count || (column.isInt && keepsType);
+    result.validity.assign(n, 0);
+    if (result.isInt) {
+        result.ints.assign(n, 0);
+    } else {
+        result.ints.clear();
+        result.doubles.assign(n, 0.0);
+    }
+
+    auto store = [&](size_t i, bool ok, auto value) {
+        result.validity[i] = ok;
+        if (result.isInt) {
+            result.ints[i] = ok ? static_cast<int64_t>(value) : 0;
+        } else {
+            result.doubles[i] = ok ? static_cast<double>(value) : 0.0;
+        }
+    };
+
+    visitValues(column, [&](auto values) {
+        using T = std::remove_const_t<std::remove_pointer_t<decltype(values)>>;
+        const uint8_t* validity = column.validity.data();
+        auto slide = [&](auto running, const auto& emit) {
+            using State = WindowState<T, decltype(running)>;
+            slideWindow(n, window, [&] { return State(values, validity); }, emit);
+        };
+
+        if (agg == WindowAgg::Min || agg == WindowAgg::Max) {
+            auto emit = [&](size_t i, const auto& state) {
+                bool ok = state.count >= minPeriods;
+                store(i, ok, ok ? values[state.running.row()] : T(0));
+            };
+            if (agg == WindowAgg::Max) {
+                slide(RunningExtreme<true>(), emit);
+            } else {
+                slide(RunningExtreme<false>(), emit);
+            }
+        } else if (agg == WindowAgg::Var) {
+            slide(RunningMoments(), [&](size_t i, const auto& state) {
+                double variance = state.running.variance(ddof);
+                store(i, state.count >= minPeriods && variance == variance, variance);
+            });
+        } else {
+            // Count, sum and mean share the running sum, in 64-bit integers for integer columns
+            using Acc = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+            slide(RunningSum<Acc>(), [&](size_t i, const auto& state) {
+                bool ok = state.count >= minPeriods;
+                if (agg == WindowAgg::Count) {
+                    store(i, ok, state.count);
+                } else if (agg == WindowAgg::Sum) {
+                    store(i, ok, state.running.value());
+                } else {
+                    store(i, ok, static_cast<double>(state.running.value()) / std::max<size_t>(state.count, 1));
+                }
+            });
+        }
+    });
+    finishColumn(result);
+    return result;
+}
+
+/**
+ * @brief Computes the running combination of the values from the first row, nan-values and NaN doubles are skipped
+ * and stay nan-values.
+ *
+ * Morsels are scanned in parallel twice: once to combine the values of each morsel, then, starting from the
+ * combination of the preceding morsels, to write the running values.
+ *
+ * @param keepInt Keeps integer columns integral, `combine` is called with doubles otherwise.
+ */
+template <typename Combine>
+TypedColumn cumulative(const TypedColumn& column, bool keepInt, const Combine& combine) {
+    size_t n = column.size();
+    TypedColumn result;
+    result.isInt = column.isInt && keepInt;
+    result.validity = column.validity;
+    if (result.isInt) {
+        result.ints.assign(n, 0);
+    } else {
+        result.doubles.assign(n, 0.0);
+    }
+
+    visitValues(column, [&](auto values) {
+        auto run = [&](auto* out) {
+            using Acc = std::remove_pointer_t<decltype(out)>;
+            struct Partial {
+                bool started = false;
+                Acc value = 0;
+                void add(Acc next, const Combine& combine) {
+                    value = started ? combine(value, next) : next;
+                    started = true;
+                }
+            };
+            const uint8_t* validity = column.validity.data();
+            auto holdsValue = [&](size_t i) { return validity[i] && values[i] == values[i]; };
+
+            std::vector<Partial> carry(parallel::morselCount(n));
+            parallel::forEachMorsel(n, [&](size_t m, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    if (holdsValue(i)) {
+                        carry[m].add(static_cast<Acc>(values[i]), combine);
+                    }
+                }
+            });
+            Partial previous;
+            for (auto& partial : carry) {
+                Partial total = previous;
+                if (partial.started) {
+                    total.add(partial.value, combine);
+                }
+                partial = previous;
+                previous = total;
+            }
+            parallel::forEachMorsel(n, [&](size_t m, size_t begin, size_t end) {
+                Partial acc = carry[m];
+                for (size_t i = begin; i < end; i++) {
+                    if (holdsValue(i)) {
+                        acc.add(static_cast<Acc>(values[i]), combine);
+                        out[i] = acc.value;
+                    } else {
+                        result.validity[i] = 0;
+                    }
+                }
+            });
+        };
+        if (result.isInt) {
+            run(result.ints.data());
+        } else {
+            run(result.doubles.data());
+        }
+    });
+    finishColumn(result);
+    return result;
+}
+
+/**
+ * @brief Computes `op(value[i], value[i - periods])` for every row, a nan-value where either side is missing or out
+ * of the column.
+ *
+ * @param keepInt Keeps integer columns integral, `op` is called with doubles otherwise.
+ */
+template <typename Op>
+TypedColumn lagOp(const TypedColumn& column, long long periods, bool keepInt, const Op& op) {
+    size_t n = column.size();
+    TypedColumn result;
+    result.isInt = column.isInt && keepInt;
+    result.validity.assign(n, 0);
+    if (result.isInt) {
+        result.ints.assign(n, 0);
+    } else {
+        result.doubles.assign(n, 0.0);
+    }
+    visitValues(column, [&](auto values) {
+        parallel::forEachMorsel(n, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                long long j = static_cast<long long>(i) - periods;
+                if (j < 0 || j >= static_cast<long long>(n) || !column.validity[i] || !column.validity[j]) {
+                    continue;
+                }
+                result.validity[i] = 1;
+                if (result.isInt) {
+                    result.ints[i] = op(static_cast<int64_t>(values[i]), static_cast<int64_t>(values[j]));
+                } else {
+                    result.doubles[i] = op(static_cast<double>(values[i]), static_cast<double>(values[j]));
+                }
+            }
+        });
+    });
+    finishColumn(result);
+    return result;
+}
+
+}  // namespace kernels
+
+}  // namespace cdf
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef ZONEMAP_HPP
+#define ZONEMAP_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "dtypes.hpp"
+
+namespace cdf {
+
+namespace core {
+
+/**
+ * @brief What the statistics of a chunk tell about a comparison
+ */
+enum class ChunkMatch {
+    None, /**< No row of the chunk can match */
+    Some, /**< Rows have to be compared one by one */
+    All   /**< Every row of the chunk matches */
+};
+
+/**
+ * @brief Statistics of a chunk of rows
+ */
+struct ChunkStats {
+    size_t rows = 0;
+    size_t nulls = 0;   /**< Nan-values */
+    size_t nans = 0;    /**< Doubles holding NaN, never part of min and max */
+    size_t numbers = 0; /**< Integers and doubles, NaN doubles included */
+    size_t strings = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    std::string minString;
+    std::string maxString;
+};
+
+/**
+ * @class ZoneMap
+ * @brief Min/max/null statistics of fixed-size chunks of a column, used to skip chunks during comparisons.
+ *
+ * Numbers and strings keep separate bounds. A comparison with a number only considers the numbers of a chunk (strings
+ * and nan-values never match it), a comparison with a string can only be decided for chunks without numbers, since
+ * numbers are compared to strings through their text. Appending a value updates the statistics of the last chunk.
+ */
+class ZoneMap {
+    size_t chunkSize;
+    std::vector<ChunkStats> chunks;
+
+    /**
+     * @brief Classifies a chunk from the bounds of its candidate values
+     *
+     * @param complete Whether every row of the chunk is a candidate (no nan-value, no value of the other kind)
+     */
+    template <typename T, typename Comparator>
+    static ChunkMatch classify(const T& min, const T& max, const T& probe, bool complete, const Comparator&) {
+        bool none = false, all = false;
+        if constexpr (std::is_same_v<Comparator, std::equal_to<>>) {
+            none = probe < min || max < probe;
+            all = !(min < probe) && !(probe < max);
+        } else if constexpr (std::is_same_v<Comparator, std::not_equal_to<>>) {
+            none = !(min < probe) && !(probe < max);
+            all = probe < min || max < probe;
+        } else if constexpr (std::is_same_v<Comparator, std::less<>>) {
+            none = !(min < probe);
+            all = max < probe;
+        } else if constexpr (std::is_same_v<Comparator, std::less_equal<>>) {
+            none = probe < min;
+            all = !(probe < max);
+        } else if constexpr (std::is_same_v<Comparator, std::greater<>>) {
+            none = !(probe < max);
+            all = probe < min;
+        } else if constexpr (std::is_same_v<Comparator, std::greater_equal<>>) {
+            none = max < probe;
+            all = !(min < probe);
+        } else {
+            return ChunkMatch::Some;
+        }
+        if (none) {
+            return ChunkMatch::None;
+        }
+        return all && complete ? ChunkMatch::All : ChunkMatch::Some;
+    }
+
+   public:
+    static constexpr size_t defaultChunkSize = 1 << 16;
+
+    /**
+     * @brief Builds the statistics of the given values.
+     *
+     * @param chunkSize Rows per chunk (default is 65536).
+     */
+    explicit ZoneMap(const std::vector<_cdfVal>& values = {}, size_t chunkSize = defaultChunkSize)
+        : chunkSize(std::max<size_t>(1, chunkSize)) {
+        chunks.reserve((values.size() + this->chunkSize - 1) / this->chunkSize);
+        for (auto& value : values) {
+            append(value);
+        }
+    }
+
+    /**
+     * @brief Adds a value after the last row.
+     */
+    void append(const _cdfVal& value) {
+        if (chunks.empty() || chunks.back().rows == chunkSize) {
+            chunks.emplace_back();
+        }
+        ChunkStats& chunk = chunks.back();
+        chunk.rows++;
+        if (std::holds_alternative<NaN>(value)) {
+            chunk.nulls++;
+        } else if (std::holds_alternative<std::string>(value)) {
+            const std::string& text = std::get<std::string>(value);
+            if (chunk.strings == 0 || text < chunk.minString) {
+                chunk.minString = text;
+            }
+            if (chunk.strings == 0 || chunk.maxString < text) {
+                chunk.maxString = text;
+            }
+            chunk.strings++;
+        } else {
+            double number = std::holds_alternative<int>(value) ? std::get<int>(value) : std::get<double>(value);
+            chunk.numbers++;
+            if (std::isnan(number)) {
+                chunk.nans++;
+            } else {
+                chunk.min = std::min(chunk.min, number);
+                chunk.max = std::max(chunk.max, number);
+            }
+        }
+    }
+
+    size_t chunkRows() const { return chunkSize; }
+    size_t numChunks() const { return chunks.size(); }
+    const ChunkStats& chunk(size_t index) const { return chunks[index]; }
+
+    /**
+     * @brief Tells whether the rows of a chunk can match `op(value, probe)`, with the semantics of the `Series`
+     * comparison operators.
+     */
+    template <typename V, typename Comparator>
+    ChunkMatch match(size_t index, const V& probe, const Comparator& op) const {
+        const ChunkStats& chunk = chunks[index];
+        if constexpr (std::is_same_v<V, std::string>) {
+            if (chunk.numbers > 0) {
+                return ChunkMatch::Some;
+            }
+            if (chunk.strings == 0) {
+                return ChunkMatch::None;
+            }
+            return classify(chunk.minString, chunk.maxString, probe, chunk.strings == chunk.rows, op);
+        } else {
+            double number = static_cast<double>(probe);
+            if (std::isnan(number)) {
+                return ChunkMatch::Some;
+            }
+            if constexpr (std::is_same_v<Comparator, std::not_equal_to<>>) {
+                // NaN doubles are left out of the bounds, yet differ from every probe
+                if (chunk.nans > 0) {
+                    return ChunkMatch::Some;
+                }
+            }
+            if (chunk.numbers == chunk.nans) {
+                return ChunkMatch::None;
+            }
+            return classify(chunk.min, chunk.max, number, chunk.numbers - chunk.nans == chunk.rows, op);
+        }
+    }
+
+    /**
+     * @brief Returns the number of bytes held by the statistics.
+     */
+    size_t memoryBytes() const {
+        size_t bytes = chunks.capacity() * sizeof(ChunkStats);
+        for (auto& chunk : chunks) {
+            bytes += chunk.minString.capacity() > 15 ? chunk.minString.capacity() + 1 : 0;
+            bytes += chunk.maxString.capacity() > 15 ? chunk.maxString.capacity() + 1 : 0;
+        }
+        return bytes;
+    }
+};
+
+}  // namespace core
+
+}  // namespace cdf
+
+#endif